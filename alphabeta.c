@@ -1,101 +1,384 @@
+#include <string.h>
+#include <time.h>
 #include "hex.h"
 
+// Réglages de la recherche, modifiables à l'exécution (set_search_params)
+SearchParams search_params = {
+    .lmr = 1,
+    .lmr_min_depth = 3,
+    .lmr_full_moves = 4,
+    .lmr_reduction = 2, // Nombre pair : la feuille réduite garde le même joueur au trait
+    .ext = 0, // Extensions coûteuses (2 plis) et sans gain contre Random : désactivées par défaut
+    .ext_max = 1,
+    .ext_threat = 2,
+    .ext_bridge = 0,
+    .deterministic = 0,
+};
+
+// Applique une liste "nom=valeur,nom=valeur". Retourne -1 si un nom est inconnu.
+int set_search_params(const char *list) {
+    struct { const char *name; int *value; } params[] = {
+        {"lmr", &search_params.lmr},
+        {"lmr_depth", &search_params.lmr_min_depth},
+        {"lmr_full", &search_params.lmr_full_moves},
+        {"lmr_red", &search_params.lmr_reduction},
+        {"ext", &search_params.ext},
+        {"ext_max", &search_params.ext_max},
+        {"ext_threat", &search_params.ext_threat},
+        {"ext_bridge", &search_params.ext_bridge},
+        {"det", &search_params.deterministic},
+    };
+    int ret = 0;
+    char name[32];
+    int value, len;
+    while (sscanf(list, " %31[^=,]=%d%n", name, &value, &len) == 2) {
+        bool found = false;
+        for (size_t k = 0; k < sizeof(params) / sizeof(params[0]); k++) {
+            if (strcmp(name, params[k].name) == 0) {
+                *params[k].value = value;
+                found = true;
+            }
+        }
+        if (!found) ret = -1;
+        list += len;
+        if (*list != ',') break;
+        list++;
+    }
+    return ret;
+}
+
+// Démarrage commun à hex_game, selfplay et test_ia : poids de l'évaluation,
+// réglages HEX_SEARCH (ex: lmr=0,ext=0), graine HEX_SEED (mode déterministe).
+// Retourne la graine, l'heure si HEX_SEED est absent.
+unsigned long long engine_setup(void) {
+    load_weights(NULL); // Défaut si absent
+    const char *reglages = getenv("HEX_SEARCH");
+    if (reglages != NULL && set_search_params(reglages) != 0) {
+        printf("Réglage inconnu dans HEX_SEARCH: %s\n", reglages);
+    }
+
+    const char *graine = getenv("HEX_SEED");
+    if (graine == NULL) return (unsigned long long)time(NULL);
+    search_params.deterministic = 1;
+    return strtoull(graine, NULL, 10);
+}
+
+// Catégories d'un coup pour l'ordre de recherche
+#define MOVE_QUIET 0
+#define MOVE_BRIDGE 1 // Forme un pont avec une pierre du joueur
+#define MOVE_PATH 2 // Sur un plus court chemin du joueur
+#define MOVE_BLOCK 4 // Coupe un plus court chemin de l'adversaire
+#define MOVE_THREAT 8 // Coupe l'adversaire alors qu'il est près de gagner
+
+// Liste les coups triés : blocages, puis chemin du joueur, puis ponts, puis le reste
+// moves reçoit les indices des cases (CELL) dans l'ordre de recherche
+static int order_moves(HexGame *game, char player, int moves[MAX_MOVES], int flags[MAX_MOVES]) {
+    char opponent = (player == PLAYER1) ? PLAYER2 : PLAYER1;
+    bool own_path[MAX_CELLS], opp_path[MAX_CELLS];
+    path_cells(game, player, own_path);
+    int d_opp = path_cells(game, opponent, opp_path);
+
+    // Tri par paniers (4 bits de catégorie -> 16 paniers), stable dans chaque panier
+    int count[16] = {0};
+    int cat[MAX_MOVES];
+    int nb = 0;
+    for (int i = 0; i < game->size; i++) {
+        for (int j = 0; j < game->size; j++) {
+            int idx = CELL(game, i, j);
+            if (game->cells[idx] != EMPTY) continue;
+            int f = MOVE_QUIET;
+            if (opp_path[idx]) f |= MOVE_BLOCK;
+            if (opp_path[idx] && d_opp <= search_params.ext_threat) f |= MOVE_THREAT;
+            if (own_path[idx]) f |= MOVE_PATH;
+            if (creates_bridge(game, idx, player)) f |= MOVE_BRIDGE;
+            cat[nb] = idx;
+            flags[nb++] = f;
+            count[f]++;
+        }
+    }
+    int start[16];
+    int pos = 0;
+    for (int f = 15; f >= 0; f--) {
+        start[f] = pos;
+        pos += count[f];
+    }
+    int sorted_flags[MAX_MOVES];
+    for (int k = 0; k < nb; k++) {
+        int f = flags[k];
+        moves[start[f]] = cat[k];
+        sorted_flags[start[f]++] = f;
+    }
+    memcpy(flags, sorted_flags, nb * sizeof(int));
+    return nb;
+}
+
 // Algorithme Alpha-Bêta
-int alphabeta(HexGame *game, int prof, int alpha, int beta, bool isMax) {
+// Coups triés, réduction des coups tardifs et calmes (LMR), extension des coups
+// qui bloquent une menace ou forment un pont (ext = extensions restantes sur la branche).
+// Une extension ajoute deux plis : la feuille reste évaluée avec le même joueur au trait
+// que les autres feuilles, sinon eval compare des positions de parité différente.
+int alphabeta(HexGame *game, int prof, int alpha, int beta, bool isMax, int ext, WorkerScratch *w) {
+    w->nodes++;
+    PROF_START(t_eval);
     int score = eval(game);
+    PROF_STOP(w->prof[PROF_EVAL], t_eval);
 
     // Victoire, défaite ou limite de profondeur
     if (score == 1000 || score == -1000 || prof == 0) {
         return score;
     }
-    
-    // Tour de Max (PLAYER1)
-    if (isMax) { 
-        int best = -INF;
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (game->grid[i][j] == EMPTY) {
-                    game->grid[i][j] = PLAYER1; // Simule le coup
-                    int val = alphabeta(game, prof - 1, alpha, beta, false); // Appel récursif
-                    game->grid[i][j] = EMPTY; // Annule le coup
-                    
-                    if (val > best) best = val;
-                    if (best > alpha) alpha = best; // Maj de la borne inférieure
-                    if (beta <= alpha) return best; // L'autre player va bloquer ce coup
-                }
+
+    char player = isMax ? PLAYER1 : PLAYER2;
+    int moves[MAX_MOVES], flags[MAX_MOVES];
+    PROF_START(t_gen);
+    int nb = order_moves(game, player, moves, flags);
+    PROF_STOP(w->prof[PROF_MOVEGEN], t_gen);
+    int best = isMax ? -INF : INF;
+
+    for (int k = 0; k < nb; k++) {
+        int idx = moves[k];
+        game->cells[idx] = player; // Simule le coup
+
+        // Extension : le coup bloque un adversaire proche de la victoire (ou forme un pont)
+        bool extend = search_params.ext && ext > 0 &&
+                      ((flags[k] & MOVE_THREAT) || (search_params.ext_bridge && (flags[k] & MOVE_BRIDGE)));
+        int child_prof = extend ? prof + 1 : prof - 1;
+        int child_ext = extend ? ext - 1 : ext;
+
+        // Réduction : coup calme loin dans la liste
+        bool reduce = search_params.lmr && !extend && flags[k] == MOVE_QUIET &&
+                      k >= search_params.lmr_full_moves && prof >= search_params.lmr_min_depth;
+
+        int val;
+        if (reduce) {
+            int red_prof = child_prof - search_params.lmr_reduction;
+            if (red_prof < 0) red_prof = 0;
+            val = alphabeta(game, red_prof, alpha, beta, !isMax, child_ext, w);
+            // Le coup réduit semble améliorer la borne : recherche complète
+            if (isMax ? val > alpha : val < beta) {
+                val = alphabeta(game, child_prof, alpha, beta, !isMax, child_ext, w);
             }
+        } else {
+            val = alphabeta(game, child_prof, alpha, beta, !isMax, child_ext, w); // Appel récursif
         }
-        return best;
-    // Tour de Min (PLAYER2)
-    } else { 
-        int best = INF;
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (game->grid[i][j] == EMPTY) {
-                    game->grid[i][j] = PLAYER2; // Simule le coup
-                    int val = alphabeta(game, prof - 1, alpha, beta, true); // Appel récursif
-                    game->grid[i][j] = EMPTY; // Annule le coup
-                    
-                    if (val < best) best = val;
-                    if (best < beta) beta = best; // Maj de la borne supérieure
-                    if (beta <= alpha) return best; // L'autre player va bloquer ce coup
-                }
+        game->cells[idx] = EMPTY; // Annule le coup
+
+        // Tour de Max (PLAYER1)
+        if (isMax) {
+            if (val > best) best = val;
+            if (best > alpha) alpha = best; // Maj de la borne inférieure
+        // Tour de Min (PLAYER2)
+        } else {
+            if (val < best) best = val;
+            if (best < beta) beta = best; // Maj de la borne supérieure
+        }
+        if (beta <= alpha) return best; // L'autre player va bloquer ce coup
+    }
+    return best;
+}
+
+// État d'un coup de la racine après une passe
+#define ROOT_EXACT 0
+#define ROOT_FAIL_LOW 1 // Valeur <= borne basse : le coup est moins bon
+#define ROOT_FAIL_HIGH 2 // Valeur >= borne haute : à rechercher à nouveau
+
+// Contexte partagé par les tâches de la racine.
+// Les scores sont vus du joueur à la racine (sign = +1 pour J1, -1 pour J2).
+typedef struct {
+    HexGame *game;
+    char player;
+    int sign;
+    int vals[MAX_MOVES]; // Score de chaque coup, indicé par row * size + col
+    int status[MAX_MOVES];
+    int lo[MAX_MOVES]; // Fenêtre de recherche propre à chaque coup
+    int hi[MAX_MOVES];
+    int pending[MAX_MOVES]; // Coups à (re)chercher pendant cette passe
+    int nb_pending;
+    int best; // Meilleur score exact de la passe, partagé entre les frères
+} AlphaBetaRoot;
+
+// Score de la fin de partie précédente vu par chaque joueur (centre de la fenêtre)
+static int last_score[2];
+static bool has_last_score[2] = {false, false};
+
+// Tâche du pool : évalue un coup de la racine dans sa fenêtre
+static void alphabeta_task(WorkerScratch *w, int t, void *ctx) {
+    AlphaBetaRoot *root = ctx;
+    int idx = root->pending[t];
+    int size = root->game->size;
+
+    w->board = *root->game; // Copie dans le plateau de travail du worker
+    w->board.cells[CELL(root->game, idx / size, idx % size)] = root->player;
+
+    // Fenêtre des frères : un coup qui ne peut pas égaler le meilleur est coupé tôt.
+    // Désactivée en mode déterministe : la borne dépend de l'ordre de fin des tâches,
+    // et avec la LMR elle change les recherches (et parfois le coup) d'une exécution à l'autre.
+    int a = root->lo[idx];
+    if (!search_params.deterministic) {
+        int best;
+        #pragma omp atomic read
+        best = root->best;
+        if (best - 1 > a) a = best - 1;
+    }
+    int b = root->hi[idx];
+
+    // Appel de l'Alpha-Bêta (fail-soft) pour évaluer ce coup
+    int val;
+    if (root->sign > 0) {
+        val = alphabeta(&w->board, PROFALPHABETA, a, b, false, search_params.ext_max, w);
+    } else {
+        val = -alphabeta(&w->board, PROFALPHABETA, -b, -a, true, search_params.ext_max, w);
+    }
+
+    root->vals[idx] = val;
+    if (val <= a) {
+        root->status[idx] = ROOT_FAIL_LOW;
+    } else if (val >= b) {
+        root->status[idx] = ROOT_FAIL_HIGH;
+    } else {
+        root->status[idx] = ROOT_EXACT;
+        // Écriture atomique : la lecture des frères est une lecture atomique hors section critique
+        #pragma omp critical
+        {
+            if (val > root->best) {
+                #pragma omp atomic write
+                root->best = val;
             }
         }
-        return best;
     }
 }
 
-// Alpha-Beta + parallélisation avec OpenMP au premier niveau
-void best_move_alphabeta(HexGame *game, char player, int *Bestrow, int *Bestcol, int turn) {
+// Nouvelle partie : oublie le score du coup précédent (centre de la fenêtre)
+void reset_search(void) {
+    has_last_score[0] = false;
+    has_last_score[1] = false;
+}
+
+// Une borne au-delà des scores de victoire devient infinie
+static int window_bound(int bound) {
+    if (bound < -1000) return -INF;
+    if (bound > 1000) return INF;
+    return bound;
+}
+
+// Alpha-Beta + parallélisation sur le pool de workers au premier niveau.
+// Fenêtre d'aspiration autour du score du coup précédent, élargie en cas d'échec.
+// Les égalités sont départagées par rng, dans l'ordre des cases.
+void best_move_alphabeta(HexGame *game, char player, int *Bestrow, int *Bestcol, int turn, HexRng *rng) {
 
     // Coups aléatoires en début de partie
     if (turn < RANDTOUR) {
-        play_random_move(game, Bestrow, Bestcol);
+        play_random_move(game, rng, Bestrow, Bestcol);
         return;
     }
 
-    int bestVal = (player == PLAYER1) ? -INF : INF;
-    *Bestrow = -1; 
-    *Bestcol = -1;
+    pool_reset_arenas(); // Mémoire du coup précédent libérée d'un bloc
+
+    // Contexte de la racine pris dans l'arena du coup (plus de 7 Ko sur 19x19)
+    AlphaBetaRoot *root = arena_alloc(root_arena(), sizeof(AlphaBetaRoot));
+    if (root == NULL) {
+        fprintf(stderr, "Erreur : budget mémoire insuffisant pour la racine.\n");
+        *Bestrow = -1;
+        *Bestcol = -1;
+        return;
+    }
+    root->game = game;
+    root->player = player;
+    root->sign = (player == PLAYER1) ? 1 : -1;
+    root->nb_pending = 0;
 
-    // Parallélisation OpenMP au niveau 0 de l'arbre
-    #pragma omp parallel for num_threads(MAX_THREADS) shared(game, bestVal, Bestrow, Bestcol)
-    for (int idx = 0; idx < SIZE*SIZE; idx++) {
-        int i = idx / SIZE;
-        int j = idx % SIZE;
-
-        if (game->grid[i][j] == EMPTY) {
-            HexGame temp_game = *game; // Copie locale pour le multi-threading
-            temp_game.grid[i][j] = player;
-            
-            // Appel de l'Alpha-Bêta pour évaluer ce coup
-            int val = alphabeta(&temp_game, PROFALPHABETA, -INF, INF, (player == PLAYER2));
-
-            #pragma omp critical
-            {   
-                if (player == PLAYER1) { // Max
-                    if (val > bestVal) {
-                        bestVal = val;
-                        *Bestrow = i; 
-                        *Bestcol = j;
-                    } else if (val == bestVal && (rand() % 2 == 0)) {
-                        // Choix aléatoire en cas d'égalité
-                        *Bestrow = i; 
-                        *Bestcol = j;
-                    }
-                } else { // Min
-                    if (val < bestVal) {
-                        bestVal = val;
-                        *Bestrow = i; 
-                        *Bestcol = j;
-                    } else if (val == bestVal && (rand() % 2 == 0)) {
-                        // Choix aléatoire en cas d'égalité
-                        *Bestrow = i; 
-                        *Bestcol = j;
-                    }
+    int p = (player == PLAYER1) ? 0 : 1;
+    int delta = ASPIRATION;
+    int lo = has_last_score[p] ? window_bound(last_score[p] - delta) : -INF;
+    int hi = has_last_score[p] ? window_bound(last_score[p] + delta) : INF;
+    int size = game->size;
+    for (int idx = 0; idx < size * size; idx++) {
+        if (game->cells[CELL(game, idx / size, idx % size)] != EMPTY) continue;
+        root->lo[idx] = lo;
+        root->hi[idx] = hi;
+        root->pending[root->nb_pending++] = idx;
+    }
+
+    // Parallélisation au niveau 0 de l'arbre, jusqu'à ce que le meilleur score soit exact
+    while (root->nb_pending > 0) {
+        root->best = -INF;
+        pool_run(alphabeta_task, root, root->nb_pending);
+        PROF_START(t_pass);
+        delta *= 2;
+
+        int nb_high = 0;
+        for (int t = 0; t < root->nb_pending; t++) {
+            if (root->status[root->pending[t]] == ROOT_FAIL_HIGH) nb_high++;
+        }
+
+        // Meilleur score exact et plus haute borne fail-soft, sur tous les coups
+        // (y compris ceux laissés par les passes précédentes)
+        int bestExact = -INF, bestLow = -INF;
+        for (int idx = 0; idx < size * size; idx++) {
+            if (game->cells[CELL(game, idx / size, idx % size)] != EMPTY) continue;
+            if (root->status[idx] == ROOT_EXACT && root->vals[idx] > bestExact) bestExact = root->vals[idx];
+            if (root->status[idx] == ROOT_FAIL_LOW && root->vals[idx] > bestLow) bestLow = root->vals[idx];
+        }
+
+        int nb = root->nb_pending;
+        root->nb_pending = 0;
+        if (nb_high > 0) {
+            // Le meilleur coup est parmi ceux qui dépassent : on ne recherche qu'eux,
+            // à partir de leur borne fail-soft
+            for (int t = 0; t < nb; t++) {
+                int idx = root->pending[t];
+                if (root->status[idx] != ROOT_FAIL_HIGH) continue;
+                root->lo[idx] = root->vals[idx] - 1;
+                root->hi[idx] = window_bound(root->vals[idx] + delta);
+                root->pending[root->nb_pending++] = idx;
+            }
+        } else {
+            for (int idx = 0; idx < size * size; idx++) {
+                if (game->cells[CELL(game, idx / size, idx % size)] != EMPTY) continue;
+                if (root->status[idx] != ROOT_FAIL_LOW) continue;
+                if (bestExact == -INF) {
+                    // Tous les coups sont sous la fenêtre : on la descend pour tous,
+                    // sous la plus haute borne fail-soft (une même fenêtre pour tous les coups)
+                    root->hi[idx] = bestLow + 1;
+                    root->lo[idx] = window_bound(bestLow - delta);
+                } else if (root->vals[idx] >= bestExact) {
+                    // Sa borne n'exclut pas qu'il égale ou dépasse le meilleur exact :
+                    // fenêtre ouverte vers le haut, la recherche ne peut plus échouer au-dessus
+                    root->lo[idx] = bestExact - 1;
+                    root->hi[idx] = INF;
+                } else {
+                    continue; // Strictement moins bon que le meilleur exact
                 }
+                root->pending[root->nb_pending++] = idx;
             }
         }
+        PROF_STOP(get_pool()->prof[PROF_MERGE], t_pass);
     }
+
+    // Fusion des résultats sur le thread principal (plus de section critique)
+    PROF_START(t_merge);
+    int bestVal = -INF;
+    *Bestrow = -1; 
+    *Bestcol = -1;
+    for (int idx = 0; idx < size * size; idx++) {
+        int i = idx / size;
+        int j = idx % size;
+        if (game->cells[CELL(game, i, j)] != EMPTY || root->status[idx] != ROOT_EXACT) continue;
+        int val = root->vals[idx];
+
+        if (val > bestVal) {
+            bestVal = val;
+            *Bestrow = i; 
+            *Bestcol = j;
+        } else if (val == bestVal && (rng_next(rng) % 2 == 0)) {
+            // Choix aléatoire en cas d'égalité
+            *Bestrow = i; 
+            *Bestcol = j;
+        }
+    }
+
+    PROF_STOP(get_pool()->prof[PROF_MERGE], t_merge);
+
+    last_score[p] = bestVal;
+    has_last_score[p] = true;
 }
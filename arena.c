@@ -0,0 +1,72 @@
+#include "hex.h"
+
+// Arrondi à l'alignement des allocations
+static size_t align_up(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+// Arena sur un bloc déjà alloué (le budget ne grandit jamais)
+void arena_init(Arena *a, void *mem, size_t size) {
+    a->base = mem;
+    a->size = size;
+    a->used = 0;
+    a->peak = 0;
+}
+
+// Allocation par simple incrément du pointeur.
+// Retourne NULL si le budget de l'arena est épuisé (jamais de malloc).
+void *arena_alloc(Arena *a, size_t bytes) {
+    size_t n = align_up(bytes);
+    if (n > a->size - a->used) return NULL;
+    void *p = a->base + a->used;
+    a->used += n;
+    if (a->used > a->peak) a->peak = a->used;
+    return p;
+}
+
+// Libère tout d'un coup (entre deux coups). Le pic est conservé pour les stats.
+void arena_reset(Arena *a) {
+    a->used = 0;
+}
+
+// Pool de noeuds de taille fixe sur un bloc de bytes octets réservé d'avance.
+// Le bloc n'appartient à aucune arena : arena_reset ne peut pas le redistribuer.
+void node_pool_init(NodePool *p, void *mem, size_t bytes, size_t node_size) {
+    // Un noeud libre doit pouvoir contenir le pointeur de la free list
+    if (node_size < sizeof(void *)) node_size = sizeof(void *);
+    p->base = mem;
+    p->node_size = align_up(node_size);
+    p->capacity = bytes / p->node_size;
+    p->peak_live = 0;
+    node_pool_reset(p);
+}
+
+// Réutilise d'abord un noeud libéré, sinon découpe le bloc.
+// Retourne NULL quand les capacity noeuds sont utilisés.
+void *node_alloc(NodePool *p) {
+    void *node;
+    if (p->free_list != NULL) {
+        node = p->free_list;
+        p->free_list = *(void **)node;
+    } else {
+        if (p->carved == p->capacity) return NULL; // Budget épuisé
+        node = p->base + p->carved * p->node_size;
+        p->carved++;
+    }
+    p->live++;
+    if (p->live > p->peak_live) p->peak_live = p->live;
+    return node;
+}
+
+void node_free(NodePool *p, void *node) {
+    *(void **)node = p->free_list;
+    p->free_list = node;
+    p->live--;
+}
+
+// Libère tous les noeuds d'un coup (entre deux coups). Le pic est conservé.
+void node_pool_reset(NodePool *p) {
+    p->carved = 0;
+    p->free_list = NULL;
+    p->live = 0;
+}
@@ -6,34 +6,223 @@
 #include <stdbool.h>
 #include <omp.h>
 
+#define TYPE_RANDOM 0
 #define TYPE_HUMAN 1
 #define TYPE_MINIMAX 2
 #define TYPE_ALPHABETA 3
-#define SIZE 6 // Taille du plateau 6x6
+#define SIZE 6 // Taille par défaut du plateau 6x6
+#define MAX_SIZE 19 // Taille maximale du plateau 19x19
+#define BORDER_W 2 // Largeur de la bordure sentinelle (un pont va jusqu'à 2 cases)
+#define MAX_STRIDE (MAX_SIZE + 2 * BORDER_W)
+#define MAX_CELLS (MAX_STRIDE * MAX_STRIDE) // Cases du tableau, bordure comprise
+#define MAX_MOVES (MAX_SIZE * MAX_SIZE)
 #define EMPTY '.'
+#define BORDER '#' // Case sentinelle hors du plateau
 #define PLAYER1 'X' // Joueur 1 Rouge Haut-Bas
 #define PLAYER2 'O' // Joueur 2 Bleu Gauche-Droite
 #define INF 10000
 #define RANDTOUR 0 // Nombre de tours rand avant que l'IA joue
 #define PROFMINIMAX 4 // Profondeur Minimax
 #define PROFALPHABETA 4 // Profondeur Alpha-Bêta
-#define MAX_THREADS 10 // Nombre maximum de threads pour OpenMP
+#define ASPIRATION 2 // Demi-largeur initiale de la fenêtre d'aspiration à la racine
+#define MAX_THREADS 64 // Nombre maximum de workers du pool (par défaut : nombre de coeurs)
+#define BIND_NONE 0 // Pas d'affinité CPU
+#define BIND_COMPACT 1 // Workers sur des coeurs consécutifs
+#define BIND_SPREAD 2 // Workers répartis sur tous les coeurs
+#define MEM_BUDGET (8 * 1024 * 1024) // Budget mémoire par moteur en octets (ou HEX_MEM_BUDGET en Ko)
+#define ARENA_ALIGN 16 // Alignement des allocations d'arena
+#define NODE_SIZE 64 // Taille des noeuds du pool de chaque worker (une ligne de cache)
+#define NODE_SHARE 2 // 1/NODE_SHARE de la part d'un worker est réservée à son pool de noeuds
+#define WEIGHTS_FILE "hex_weights.txt" // Poids de l'évaluation chargés au démarrage
+#define RECORD_VERSION 1 // Version du format binaire des parties
+#define RECORD_BUFFER (1024 * 1024) // Taille du tampon d'écriture des parties
 
+// Plateau en 1D avec bordure sentinelle : les voisins d'une case sont à des
+// décalages fixes (stride = size + 2 * BORDER_W) sans test de limites.
 typedef struct {
-    char grid[SIZE][SIZE];
+    int size;
+    int stride;
+    char cells[MAX_CELLS];
 } HexGame;
 
+// Générateur pseudo-aléatoire propre à une partie (splitmix64), à la place de rand()
+typedef struct {
+    unsigned long long state;
+} HexRng;
+
+// Indice de la case (row, col) dans cells
+#define CELL(game, r, c) (((r) + BORDER_W) * (game)->stride + (c) + BORDER_W)
+#define CELL_ROW(game, idx) ((idx) / (game)->stride - BORDER_W)
+#define CELL_COL(game, idx) ((idx) % (game)->stride - BORDER_W)
+
+// Réglages de la recherche Alpha-Bêta (voir set_search_params)
+typedef struct {
+    int lmr; // 1 = réduction des coups tardifs activée
+    int lmr_min_depth; // Profondeur restante minimale pour réduire
+    int lmr_full_moves; // Nombre de coups jamais réduits
+    int lmr_reduction; // Plis retirés à un coup réduit
+    int ext; // 1 = extensions activées
+    int ext_max; // Extensions maximales sur une branche
+    int ext_threat; // Distance adverse à partir de laquelle un blocage est étendu
+    int ext_bridge; // 1 = les coups qui forment un pont sont aussi étendus
+    int deterministic; // 1 = pas de fenêtre partagée entre frères : même coup quel que soit le nombre de workers
+} SearchParams;
+
+extern SearchParams search_params;
+
+// Caractéristiques de l'évaluation (voir position_features)
+#define F_DIST 0 // d2 - d1
+#define F_BRIDGE 1 // Ponts intacts J1 - J2
+#define F_CENTER 2 // Pierres au centre J1 - J2
+#define F_TEMPO 3 // +1 si J1 au trait, -1 sinon
+#define NB_FEATURES 4
+
+extern int eval_weights[NB_FEATURES];
+extern const char *feature_names[NB_FEATURES];
+
+// Chronomètres par phase du moteur, compilés seulement avec -DHEX_PROFILE (make PROFILE=1)
+#define PROF_EVAL 0 // Appels à eval dans la recherche
+#define PROF_MOVEGEN 1 // Génération et tri des coups
+#define PROF_MERGE 2 // Fusion des résultats de la racine sur le thread principal
+#define NB_PROF 3
+
+extern const char *prof_names[NB_PROF];
+
+#ifdef HEX_PROFILE
+#define PROF_START(t) double t = omp_get_wtime()
+#define PROF_STOP(acc, t) ((acc) += omp_get_wtime() - (t))
+#else
+#define PROF_START(t)
+#define PROF_STOP(acc, t)
+#endif
+
+// Allocateur par incrément, vidé d'un coup entre deux coups
+typedef struct {
+    char *base;
+    size_t size;
+    size_t used;
+    size_t peak; // Pic d'utilisation depuis la création
+} Arena;
+
+// Noeuds de taille fixe dans un bloc réservé à la création, recyclés par une free list
+typedef struct {
+    char *base;
+    size_t node_size;
+    size_t capacity; // Nombre de noeuds du bloc
+    size_t carved; // Noeuds déjà découpés dans le bloc
+    void *free_list;
+    long live; // Noeuds en cours d'utilisation
+    long peak_live;
+} NodePool;
+
+// Mémoire de travail d'un worker, allouée une seule fois à la création du pool
+typedef struct {
+    HexGame board; // Plateau de travail
+    long nodes; // Noeuds visités
+    double prof[NB_PROF]; // Temps par phase (HEX_PROFILE)
+    Arena arena; // Part du budget mémoire réservée au worker
+    NodePool node_pool; // Noeuds de NODE_SIZE octets pris sur la même part
+    int id; // Numéro du worker
+} __attribute__((aligned(64))) WorkerScratch;
+
+typedef struct {
+    int nb_threads;
+    int bind;
+    WorkerScratch *workers;
+    void *memory; // Bloc unique de MEM_BUDGET octets découpé en arenas
+    size_t budget;
+    Arena main_arena; // Arena du thread appelant
+    double prof[NB_PROF]; // Temps par phase du thread appelant (HEX_PROFILE)
+} EnginePool;
+
+// Statistiques exposées par le moteur
+typedef struct {
+    long nodes;
+    size_t mem_budget;
+    size_t mem_peak; // Somme des pics des arenas et des pools de noeuds
+    double prof[NB_PROF]; // Temps par phase, tous threads confondus (HEX_PROFILE)
+} EngineStats;
+
+// Tâche de recherche exécutée par un worker
+typedef void (*PoolTask)(WorkerScratch *w, int task, void *ctx);
+
 // hex_game.c
-void init_game(HexGame *game);
+void init_game(HexGame *game, int size);
 void print_board(HexGame *game);
 bool valid_move(HexGame *game, int row, int col);
+int min_distance(HexGame *game, char player);
+int path_cells(HexGame *game, char player, bool on_path[MAX_CELLS]);
+bool has_won(HexGame *game, char player);
+bool creates_bridge(HexGame *game, int idx, char player);
+void position_features(HexGame *game, int d1, int d2, int f[NB_FEATURES]);
 int eval(HexGame *game);
-void play_random_move(HexGame *game, int *row, int *col);
+int load_weights(const char *path);
+void rng_seed(HexRng *rng, unsigned long long seed);
+unsigned int rng_next(HexRng *rng);
+void play_random_move(HexGame *game, HexRng *rng, int *row, int *col);
+
+// En-tête d'une partie enregistrée (result : 1 ou 2 = gagnant, 0 = nulle)
+typedef struct {
+    int size;
+    int engine1; // TYPE_* du joueur 1
+    int engine2; // TYPE_* du joueur 2
+    int result;
+    int nb_moves;
+} GameHeader;
+
+typedef struct {
+    FILE *f;
+    unsigned char *buf;
+    size_t len;
+    long nb_games;
+} RecordWriter;
+
+typedef struct {
+    const unsigned char *data; // Fichier mappé en mémoire
+    size_t size;
+    size_t pos;
+    int fd;
+} RecordReader;
+
+// arena.c
+void arena_init(Arena *a, void *mem, size_t size);
+void *arena_alloc(Arena *a, size_t bytes);
+void arena_reset(Arena *a);
+void node_pool_init(NodePool *p, void *mem, size_t bytes, size_t node_size);
+void *node_alloc(NodePool *p);
+void node_free(NodePool *p, void *node);
+void node_pool_reset(NodePool *p);
+
+// pool.c
+void pool_init(int nb_threads, int bind, size_t budget);
+void pool_free(void);
+EnginePool *get_pool(void);
+void pool_run(PoolTask task, void *ctx, int nb_tasks);
+long pool_nodes(void);
+void pool_reset_stats(void);
+void pool_reset_arenas(void);
+Arena *main_arena(void);
+Arena *root_arena(void);
+void pool_stats(EngineStats *stats);
+
+// record.c
+int record_move_bytes(int size);
+int record_open(RecordWriter *w, const char *path);
+int record_write(RecordWriter *w, const GameHeader *h, const unsigned short *moves);
+int record_close(RecordWriter *w);
+int reader_open(RecordReader *r, const char *path);
+bool reader_next(RecordReader *r, GameHeader *h, const unsigned char **moves);
+int record_move(const GameHeader *h, const unsigned char *moves, int k);
+void reader_close(RecordReader *r);
 
 // minimax.c
-void best_move_minimax(HexGame *game, char player, int *row, int *col, int turn);
+void best_move_minimax(HexGame *game, char player, int *row, int *col, int turn, HexRng *rng);
 
 // alphabeta.c
-void best_move_alphabeta(HexGame *game, char player, int *row, int *col, int turn);
+int set_search_params(const char *list);
+unsigned long long engine_setup(void);
+int alphabeta(HexGame *game, int prof, int alpha, int beta, bool isMax, int ext, WorkerScratch *w);
+void reset_search(void);
+void best_move_alphabeta(HexGame *game, char player, int *row, int *col, int turn, HexRng *rng);
 
 #endif
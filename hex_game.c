@@ -1,26 +1,45 @@
+#include <string.h>
 #include "hex.h"
  
 int cases_adjacentes[6][2] = {{-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}}; //(row, col)
 
-void init_game(HexGame *game) {
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            game->grid[i][j] = EMPTY;
+// Ponts : case cible puis les deux cases vides qui les relient (row, col)
+// Les 3 derniers sont les opposés des 3 premiers.
+int ponts[6][3][2] = {
+    {{-2, 1}, {-1, 0}, {-1, 1}}, {{-1, 2}, {-1, 1}, {0, 1}}, {{1, 1}, {0, 1}, {1, 0}},
+    {{2, -1}, {1, 0}, {1, -1}}, {{1, -2}, {1, -1}, {0, -1}}, {{-1, -1}, {0, -1}, {-1, 0}}
+};
+
+// Poids de l'évaluation, remplacés par load_weights (par défaut : d2 - d1)
+int eval_weights[NB_FEATURES] = {1, 0, 0, 0};
+const char *feature_names[NB_FEATURES] = {"dist", "bridge", "center", "tempo"};
+
+// Plateau vide de taille size (2 à MAX_SIZE) entouré de cases BORDER
+void init_game(HexGame *game, int size) {
+    game->size = size;
+    game->stride = size + 2 * BORDER_W;
+    for (int k = 0; k < game->stride * game->stride; k++) {
+        game->cells[k] = BORDER;
+    }
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            game->cells[CELL(game, i, j)] = EMPTY;
         }
     }
 }
 
 void print_board(HexGame *game) {
-    printf("\n  ");
-    for (int j = 0; j < SIZE; j++) printf("%c ", 'A' + j); // colonnes
+    int w = (game->size >= 10) ? 2 : 1; // Largeur des numéros de ligne
+    printf("\n%*s", w + 1, "");
+    for (int j = 0; j < game->size; j++) printf("%c ", 'A' + j); // colonnes
     printf("\n");
-    for (int i = 0; i < SIZE; i++) { // lignes
+    for (int i = 0; i < game->size; i++) { // lignes
         for (int k = 0; k < i; k++) {
             printf(" "); // décalage
         }
-        printf("%d", i + 1); // Numéro de ligne
-        for (int j = 0; j < SIZE; j++) {
-            char c = game->grid[i][j];
+        printf("%*d", w, i + 1); // Numéro de ligne
+        for (int j = 0; j < game->size; j++) {
+            char c = game->cells[CELL(game, i, j)];
             // Joueur 1 rouge et Joueur 2 bleu
             if (c == PLAYER1) printf(" \033[1;31m%c\033[0m", c);
             else if (c == PLAYER2) printf(" \033[1;34m%c\033[0m", c);
@@ -32,86 +51,196 @@ void print_board(HexGame *game) {
 }
 // Vérifie si la case est valide et vide
 bool valid_move(HexGame *game, int row, int col) {
-    return (row >= 0 && row < SIZE && col >= 0 && col < SIZE && game->grid[row][col] == EMPTY);
+    return (row >= 0 && row < game->size && col >= 0 && col < game->size &&
+            game->cells[CELL(game, row, col)] == EMPTY);
+}
+
+// Décalages des 6 voisins dans le tableau 1D
+static void neighbour_offsets(HexGame *game, int off[6]) {
+    for (int k = 0; k < 6; k++) {
+        off[k] = cases_adjacentes[k][0] * game->stride + cases_adjacentes[k][1];
+    }
 }
 
 // Algorithme 0-1 BFS (Deque) pour les poids 0 et 1.
-// Cherche la distance minimale qu'un joueur doit parcourir pour gagner.
-int min_distance(HexGame *game, char player) {
-    int dist[SIZE][SIZE];
-    for(int i=0; i<SIZE; i++) 
-        for(int j=0; j<SIZE; j++) 
-            dist[i][j] = INF;
+// Remplit dist avec le coût minimal pour relier chaque case à un bord du joueur :
+// bord de départ (ligne 0 / colonne 0) ou bord d'arrivée si far_edge.
+// Les cases BORDER pèsent INF comme les pierres adverses : aucun test de limites.
+static void edge_distances(HexGame *game, char player, bool far_edge, int dist[MAX_CELLS]) {
+    int size = game->size;
+    int off[6];
+    neighbour_offsets(game, off);
+
+    for (int i = 0; i < size; i++)
+        for (int j = 0; j < size; j++)
+            dist[CELL(game, i, j)] = INF;
 
     // Deque pour 0-1 BFS (on utilise un tableau circulaire)
-    int deque[SIZE * SIZE * 2];
-    int front = SIZE * SIZE; // Début au milieu pour pouvoir ajouter devant
-    int rear = SIZE * SIZE;
+    int deque[MAX_MOVES * 2];
+    int front = size * size; // Début au milieu pour pouvoir ajouter devant
+    int rear = size * size;
+    int edge = far_edge ? size - 1 : 0;
 
     // Initialisation de la deque avec le bord de départ
-    if (player == PLAYER1) { // Joueur X doit relier ligne 0 à ligne SIZE-1
-        for (int j = 0; j < SIZE; j++) {
-            if (game->grid[0][j] == player) {
-                dist[0][j] = 0; // Case déjà occupée par le joueur coût 0
-                deque[--front] = 0 * SIZE + j; // Poids 0 -> devant
-            } else if (game->grid[0][j] == EMPTY) {
-                dist[0][j] = 1; // Case vide coût 1
-                deque[rear++] = 0 * SIZE + j; // Poids 1 -> derrière
-            }
-        }
-    } else { // Joueur O doit relier colonne 0 à colonne SIZE-1
-        for (int i = 0; i < SIZE; i++) {
-            if (game->grid[i][0] == player) {
-                dist[i][0] = 0;
-                deque[--front] = i * SIZE + 0; // Poids 0 -> devant
-            } else if (game->grid[i][0] == EMPTY) {
-                dist[i][0] = 1;
-                deque[rear++] = i * SIZE + 0; // Poids 1 -> derrière
-            }
+    for (int k = 0; k < size; k++) {
+        // Joueur X relie ligne 0 et ligne size-1, Joueur O colonne 0 et colonne size-1
+        int idx = (player == PLAYER1) ? CELL(game, edge, k) : CELL(game, k, edge);
+        if (game->cells[idx] == player) {
+            dist[idx] = 0; // Case déjà occupée par le joueur coût 0
+            deque[--front] = idx; // Poids 0 -> devant
+        } else if (game->cells[idx] == EMPTY) {
+            dist[idx] = 1; // Case vide coût 1
+            deque[rear++] = idx; // Poids 1 -> derrière
         }
     }
 
     // Boucle 0-1 BFS
     while (front < rear) {
         int curr = deque[front++];
-        int r = curr / SIZE;
-        int c = curr % SIZE;
 
-        // Vérification des 6 voisins
+        // Vérification des 6 voisins (décalages fixes grâce à la bordure)
         for (int k = 0; k < 6; k++) {
-            int nr = r + cases_adjacentes[k][0];
-            int nc = c + cases_adjacentes[k][1];
-
-            if (nr >= 0 && nr < SIZE && nc >= 0 && nc < SIZE) {
-                char cell = game->grid[nr][nc];
-                // 0 si occupé par soi, 1 si vide, INF si bloqué par l'autre
-                int weight = (cell == player) ? 0 : ((cell == EMPTY) ? 1 : INF);
-                
-                if (weight != INF && dist[r][c] + weight < dist[nr][nc]) {
-                    dist[nr][nc] = dist[r][c] + weight;
-                    if (weight == 0) {
-                        deque[--front] = nr * SIZE + nc; // Poids 0 -> devant
-                    } else {
-                        deque[rear++] = nr * SIZE + nc;  // Poids 1 -> derrière
-                    }
+            int n = curr + off[k];
+            char cell = game->cells[n];
+            // 0 si occupé par soi, 1 si vide, INF si bloqué par l'autre ou hors plateau
+            int weight = (cell == player) ? 0 : ((cell == EMPTY) ? 1 : INF);
+
+            if (weight != INF && dist[curr] + weight < dist[n]) {
+                dist[n] = dist[curr] + weight;
+                if (weight == 0) {
+                    deque[--front] = n; // Poids 0 -> devant
+                } else {
+                    deque[rear++] = n;  // Poids 1 -> derrière
                 }
             }
         }
     }
+}
 
-    // Trouver la distance minimale vers le bord de victoire
+// Distance minimale vers le bord d'arrivée à partir des distances du bord de départ
+static int far_edge_distance(HexGame *game, char player, int dist[MAX_CELLS]) {
+    int last = game->size - 1;
     int min_dist = INF;
-    if (player == PLAYER1) { // Joueur X doit atteindre ligne SIZE-1
-        for (int j = 0; j < SIZE; j++) {
-            if (dist[SIZE-1][j] < min_dist) min_dist = dist[SIZE-1][j];
+    for (int k = 0; k < game->size; k++) {
+        // Joueur X doit atteindre ligne size-1, Joueur O colonne size-1
+        int idx = (player == PLAYER1) ? CELL(game, last, k) : CELL(game, k, last);
+        if (dist[idx] < min_dist) min_dist = dist[idx];
+    }
+    return min_dist;
+}
+
+// Cherche la distance minimale qu'un joueur doit parcourir pour gagner.
+int min_distance(HexGame *game, char player) {
+    int dist[MAX_CELLS];
+    edge_distances(game, player, false, dist);
+    return far_edge_distance(game, player, dist);
+}
+
+// Détection rapide de victoire : parcours en profondeur des seules pierres du
+// joueur depuis son bord de départ, arrêt dès que le bord d'arrivée est atteint.
+bool has_won(HexGame *game, char player) {
+    int size = game->size;
+    int off[6];
+    neighbour_offsets(game, off);
+
+    bool seen[MAX_CELLS];
+    memset(seen, 0, game->stride * game->stride * sizeof(bool));
+    int stack[MAX_MOVES];
+    int top = 0;
+
+    for (int k = 0; k < size; k++) {
+        int idx = (player == PLAYER1) ? CELL(game, 0, k) : CELL(game, k, 0);
+        if (game->cells[idx] == player) {
+            seen[idx] = true;
+            stack[top++] = idx;
         }
-    } else { // Joueur O doit atteindre colonne SIZE-1
-        for (int i = 0; i < SIZE; i++) {
-            if (dist[i][SIZE-1] < min_dist) min_dist = dist[i][SIZE-1];
+    }
+
+    int last_row = CELL(game, size - 1, 0); // Première case de la dernière ligne
+    while (top > 0) {
+        int curr = stack[--top];
+        if (player == PLAYER1 ? curr >= last_row : CELL_COL(game, curr) == size - 1) return true;
+
+        for (int k = 0; k < 6; k++) {
+            int n = curr + off[k];
+            if (!seen[n] && game->cells[n] == player) {
+                seen[n] = true;
+                stack[top++] = n;
+            }
         }
     }
-    
-    return min_dist;
+    return false;
+}
+
+// Marque les cases vides qui sont sur au moins un plus court chemin du joueur.
+// Retourne la distance minimale (comme min_distance).
+int path_cells(HexGame *game, char player, bool on_path[MAX_CELLS]) {
+    int from_start[MAX_CELLS], from_end[MAX_CELLS];
+    edge_distances(game, player, false, from_start);
+    edge_distances(game, player, true, from_end);
+    int d = far_edge_distance(game, player, from_start);
+
+    // Une case vide compte dans les deux distances : on la retire une fois
+    for (int i = 0; i < game->size; i++) {
+        for (int j = 0; j < game->size; j++) {
+            int idx = CELL(game, i, j);
+            on_path[idx] = game->cells[idx] == EMPTY && d < INF &&
+                           from_start[idx] + from_end[idx] - 1 == d;
+        }
+    }
+    return d;
+}
+
+// Pont dans la direction k depuis idx : cible du joueur et deux cases vides.
+// La bordure fait BORDER_W cases, donc la cible est toujours dans le tableau.
+static bool bridge_at(HexGame *game, int idx, int k, char player) {
+    int s = game->stride;
+    return game->cells[idx + ponts[k][0][0] * s + ponts[k][0][1]] == player &&
+           game->cells[idx + ponts[k][1][0] * s + ponts[k][1][1]] == EMPTY &&
+           game->cells[idx + ponts[k][2][0] * s + ponts[k][2][1]] == EMPTY;
+}
+
+// Vrai si une pierre du joueur sur la case idx formerait un pont avec une de ses pierres
+bool creates_bridge(HexGame *game, int idx, char player) {
+    for (int k = 0; k < 6; k++) {
+        if (bridge_at(game, idx, k, player)) return true;
+    }
+    return false;
+}
+
+// Caractéristiques de la position du point de vue du Joueur 1 (d1, d2 déjà calculées)
+void position_features(HexGame *game, int d1, int d2, int f[NB_FEATURES]) {
+    int size = game->size;
+    int nb_x = 0, nb_o = 0, ponts_x = 0, ponts_o = 0, centre_x = 0, centre_o = 0;
+
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            int idx = CELL(game, i, j);
+            char c = game->cells[idx];
+            if (c == EMPTY) continue;
+            int sign = (c == PLAYER1) ? 1 : -1;
+            if (sign > 0) nb_x++; else nb_o++;
+
+            // Ponts intacts (3 directions pour ne compter chaque paire qu'une fois)
+            for (int k = 0; k < 3; k++) {
+                if (bridge_at(game, idx, k, c)) {
+                    if (sign > 0) ponts_x++; else ponts_o++;
+                }
+            }
+
+            // Distance hexagonale au centre (coordonnées doublées)
+            int dq = 2 * j - (size - 1);
+            int dr = 2 * i - (size - 1);
+            if ((abs(dq) + abs(dr) + abs(dq + dr)) / 2 < size) {
+                if (sign > 0) centre_x++; else centre_o++;
+            }
+        }
+    }
+
+    f[F_DIST] = d2 - d1;
+    f[F_BRIDGE] = ponts_x - ponts_o;
+    f[F_CENTER] = centre_x - centre_o;
+    f[F_TEMPO] = (nb_x == nb_o) ? 1 : -1; // Joueur 1 au trait
 }
 
 int eval(HexGame *game) {
@@ -122,17 +251,71 @@ int eval(HexGame *game) {
     if (d2 == 0) return -1000;  // Joueur 2 a gagné
     //if (d1 == INF) return -900; // Joueur 1 bloqué
     //if (d2 == INF) return 900;  // Joueur 2 bloqué
-    return d2 - d1;
+
+    int score = eval_weights[F_DIST] * (d2 - d1);
+
+    // Les autres caractéristiques demandent un parcours du plateau : seulement si un poids est non nul
+    if (eval_weights[F_BRIDGE] != 0 || eval_weights[F_CENTER] != 0 || eval_weights[F_TEMPO] != 0) {
+        int f[NB_FEATURES];
+        position_features(game, d1, d2, f);
+        for (int k = F_DIST + 1; k < NB_FEATURES; k++) score += eval_weights[k] * f[k];
+    }
+
+    // Les scores de victoire restent hors d'atteinte
+    if (score > 999) score = 999;
+    if (score < -999) score = -999;
+    return score;
+}
+
+// Charge les poids de l'évaluation (lignes "nom valeur") et les affiche.
+// path = NULL -> HEX_WEIGHTS ou WEIGHTS_FILE. Retourne -1 si le fichier est absent.
+int load_weights(const char *path) {
+    if (path == NULL) path = getenv("HEX_WEIGHTS");
+    if (path == NULL) path = WEIGHTS_FILE;
+
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return -1;
+
+    char line[128], name[64];
+    int value;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%63s %d", name, &value) != 2) continue;
+        for (int k = 0; k < NB_FEATURES; k++) {
+            if (strcmp(name, feature_names[k]) == 0) eval_weights[k] = value;
+        }
+    }
+    fclose(f);
+
+    // Un fichier de poids change l'échelle de eval : on le signale toujours
+    printf("Poids de l'évaluation lus dans %s :", path);
+    for (int k = 0; k < NB_FEATURES; k++) printf(" %s=%d", feature_names[k], eval_weights[k]);
+    printf("\n");
+    return 0;
+}
+
+// Graine de la partie : une même graine redonne la même suite de tirages
+void rng_seed(HexRng *rng, unsigned long long seed) {
+    rng->state = seed;
+}
+
+// Tirage suivant (splitmix64, 32 bits de poids fort)
+unsigned int rng_next(HexRng *rng) {
+    unsigned long long z = (rng->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (unsigned int)(z >> 32);
 }
 
-void play_random_move(HexGame *game, int *row, int *col) {
-    int empty_cells[SIZE * SIZE][2];
+void play_random_move(HexGame *game, HexRng *rng, int *row, int *col) {
+    int empty_cells[MAX_MOVES][2];
     int count = 0;
     
     // Recherche de toutes les cases vides
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            if (game->grid[i][j] == EMPTY) {
+    for (int i = 0; i < game->size; i++) {
+        for (int j = 0; j < game->size; j++) {
+            if (game->cells[CELL(game, i, j)] == EMPTY) {
                 empty_cells[count][0] = i;
                 empty_cells[count][1] = j;
                 count++;
@@ -141,7 +324,7 @@ void play_random_move(HexGame *game, int *row, int *col) {
     }
     
     if (count > 0) {
-        int r = rand() % count;
+        int r = rng_next(rng) % count;
         *row = empty_cells[r][0];
         *col = empty_cells[r][1];
     } else {
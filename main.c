@@ -1,4 +1,3 @@
-#include <time.h>
 #include "hex.h"
 
 // Jeux du joueur
@@ -15,8 +14,8 @@ void player_move(HexGame *game, int *row, int *col) {
         if (sscanf(input, " %c%d", &col_char, &r) == 2) {
             // Conversion minuscule -> majuscule
             if (col_char >= 'a' && col_char <= 'z') col_char -= 32;
-            int c = col_char - 'A'; // Conversion Lettre -> Index colonne (0-5)
-            r = r - 1; // Conversion Chiffre -> Index ligne (0-5)
+            int c = col_char - 'A'; // Conversion Lettre -> Index colonne (0 à taille-1)
+            r = r - 1; // Conversion Chiffre -> Index ligne (0 à taille-1)
             
             // Validation du coup
             if (valid_move(game, r, c)) {
@@ -32,14 +31,24 @@ void player_move(HexGame *game, int *row, int *col) {
     }
 }
 
-int main() {
-    srand(time(NULL));
+// Usage : ./hex_game [taille]  (2 à MAX_SIZE, SIZE par défaut)
+int main(int argc, char **argv) {
+    int size = (argc > 1) ? atoi(argv[1]) : SIZE;
+    if (size < 2 || size > MAX_SIZE) {
+        printf("Taille invalide (2 à %d).\n", MAX_SIZE);
+        return 1;
+    }
+
+    unsigned long long graine = engine_setup(); // Poids, HEX_SEARCH, HEX_SEED
+    HexRng rng;
+    rng_seed(&rng, graine);
+
     HexGame game;
-    init_game(&game);
+    init_game(&game, size);
     
     int type1, type2;
 
-    printf("------------- JEU HEX -------------\n");
+    printf("------------- JEU HEX %dx%d -------------\n", size, size);
     printf("Paramètre Joueur 1 \033[31mX\033[0m (Haut -> Bas) :\n");
     printf("1. Humain\n2. Minimax\n3. Alpha-Beta\nChoix : ");
     scanf("%d", &type1);
@@ -72,15 +81,15 @@ int main() {
             player_move(&game, &row, &col);
         } else if (current_type == TYPE_MINIMAX) {
             printf("Attente de Minimax \n");
-            best_move_minimax(&game, current_player, &row, &col, turn);
+            best_move_minimax(&game, current_player, &row, &col, turn, &rng);
         } else if (current_type == TYPE_ALPHABETA) {
             printf("Attente de Alpha-Beta \n");
-            best_move_alphabeta(&game, current_player, &row, &col, turn);
+            best_move_alphabeta(&game, current_player, &row, &col, turn, &rng);
         }
 
         // Exécution du coup sur le plateau
         if (row != -1 && col != -1) {
-            game.grid[row][col] = current_player;
+            game.cells[CELL(&game, row, col)] = current_player;
             if (current_type != TYPE_HUMAN) {
                 printf("IA joue en %c%d\n", 'A' + col, row + 1);
             }
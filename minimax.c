@@ -1,8 +1,11 @@
 #include "hex.h"
 
 // Algorithme Minimax
-int minimax(HexGame *game, int prof, bool isMax) {
+int minimax(HexGame *game, int prof, bool isMax, WorkerScratch *w) {
+    w->nodes++;
+    PROF_START(t_eval);
     int score = eval(game);
+    PROF_STOP(w->prof[PROF_EVAL], t_eval);
 
     // Victoire, défaite ou limite de profondeur   
     if (score == 1000 || score == -1000 || prof == 0) {
@@ -12,12 +15,13 @@ int minimax(HexGame *game, int prof, bool isMax) {
     // Tour de Max (PLAYER1)
     if (isMax) {
         int best = -INF;
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (game->grid[i][j] == EMPTY) {
-                    game->grid[i][j] = PLAYER1; // Simule le coup
-                    int val = minimax(game, prof - 1, false); // Appel récursif
-                    game->grid[i][j] = EMPTY;   // Annule le coup
+        for (int i = 0; i < game->size; i++) {
+            for (int j = 0; j < game->size; j++) {
+                int idx = CELL(game, i, j);
+                if (game->cells[idx] == EMPTY) {
+                    game->cells[idx] = PLAYER1; // Simule le coup
+                    int val = minimax(game, prof - 1, false, w); // Appel récursif
+                    game->cells[idx] = EMPTY;   // Annule le coup
                     
                     if (val > best) best = val;
                 }
@@ -27,12 +31,13 @@ int minimax(HexGame *game, int prof, bool isMax) {
     // Tour de Min (PLAYER2)
     } else {
         int best = INF;
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
-                if (game->grid[i][j] == EMPTY) {
-                    game->grid[i][j] = PLAYER2; // Simule le coup
-                    int val = minimax(game, prof - 1, true); // Appel récursif
-                    game->grid[i][j] = EMPTY;   // Annule le coup
+        for (int i = 0; i < game->size; i++) {
+            for (int j = 0; j < game->size; j++) {
+                int idx = CELL(game, i, j);
+                if (game->cells[idx] == EMPTY) {
+                    game->cells[idx] = PLAYER2; // Simule le coup
+                    int val = minimax(game, prof - 1, true, w); // Appel récursif
+                    game->cells[idx] = EMPTY;   // Annule le coup
                     
                     if (val < best) best = val;
                 }
@@ -42,53 +47,83 @@ int minimax(HexGame *game, int prof, bool isMax) {
     }
 }
 
-// Minimax + parallélisation avec OpenMP au premier niveau
-void best_move_minimax(HexGame *game, char player, int *bestRow, int *bestCol, int turn) {
+// Contexte partagé par les tâches de la racine
+typedef struct {
+    HexGame *game;
+    char player;
+    int vals[MAX_MOVES]; // Score de chaque coup (une case par tâche)
+} MinimaxRoot;
+
+// Tâche du pool : évalue le coup t (row * size + col) de la racine
+static void minimax_task(WorkerScratch *w, int t, void *ctx) {
+    MinimaxRoot *root = ctx;
+    int size = root->game->size;
+    int idx = CELL(root->game, t / size, t % size);
+    if (root->game->cells[idx] != EMPTY) return;
+
+    w->board = *root->game; // Copie dans le plateau de travail du worker
+    w->board.cells[idx] = root->player;
+
+    // Appel de Minimax pour évaluer ce coup
+    root->vals[t] = minimax(&w->board, PROFMINIMAX, (root->player == PLAYER2), w);
+}
+
+// Minimax + parallélisation sur le pool de workers au premier niveau
+// Les égalités sont départagées par rng, dans l'ordre des cases : même coup quel que soit le nombre de workers
+void best_move_minimax(HexGame *game, char player, int *bestRow, int *bestCol, int turn, HexRng *rng) {
 
     if (turn < RANDTOUR) {
-        play_random_move(game, bestRow, bestCol);
+        play_random_move(game, rng, bestRow, bestCol);
+        return;
+    }
+
+    pool_reset_arenas(); // Mémoire du coup précédent libérée d'un bloc
+
+    // Contexte de la racine pris dans l'arena du coup
+    MinimaxRoot *root = arena_alloc(root_arena(), sizeof(MinimaxRoot));
+    if (root == NULL) {
+        fprintf(stderr, "Erreur : budget mémoire insuffisant pour la racine.\n");
+        *bestRow = -1;
+        *bestCol = -1;
         return;
     }
+    root->game = game;
+    root->player = player;
+    int size = game->size;
+    pool_run(minimax_task, root, size * size);
 
+    // Fusion des résultats sur le thread principal (plus de section critique)
+    PROF_START(t_merge);
     int bestVal = (player == PLAYER1) ? -INF : INF;
     *bestRow = -1;
     *bestCol = -1;
+    for (int t = 0; t < size * size; t++) {
+        int i = t / size;
+        int j = t % size;
+        if (game->cells[CELL(game, i, j)] != EMPTY) continue;
+        int val = root->vals[t];
 
-    #pragma omp parallel for num_threads(MAX_THREADS) shared(game, bestVal, bestRow, bestCol)
-    for (int idx = 0; idx < SIZE*SIZE; idx++) {
-        int i = idx / SIZE;
-        int j = idx % SIZE;
-        if (game->grid[i][j] == EMPTY) {
-            HexGame temp_game = *game; // Copie locale pour le multi-threading
-            temp_game.grid[i][j] = player;
-            
-            // Appel de Minimax pour évaluer ce coup
-            int val = minimax(&temp_game, PROFMINIMAX, (player == PLAYER2));
-
-            #pragma omp critical
-            {
-                if (player == PLAYER1) { // Max
-                    if (val > bestVal) {
-                        bestVal = val;
-                        *bestRow = i;
-                        *bestCol = j;
-                    } else if (val == bestVal && (rand() % 2 == 0)) {
-                        // Choix aléatoire en cas d'égalité
-                        *bestRow = i;
-                        *bestCol = j;
-                    }
-                } else { // Min
-                    if (val < bestVal) {
-                        bestVal = val;
-                        *bestRow = i;
-                        *bestCol = j;
-                    } else if (val == bestVal && (rand() % 2 == 0)) {
-                        // Choix aléatoire en cas d'égalité
-                        *bestRow = i;
-                        *bestCol = j;
-                    }
-                }
+        if (player == PLAYER1) { // Max
+            if (val > bestVal) {
+                bestVal = val;
+                *bestRow = i;
+                *bestCol = j;
+            } else if (val == bestVal && (rng_next(rng) % 2 == 0)) {
+                // Choix aléatoire en cas d'égalité
+                *bestRow = i;
+                *bestCol = j;
+            }
+        } else { // Min
+            if (val < bestVal) {
+                bestVal = val;
+                *bestRow = i;
+                *bestCol = j;
+            } else if (val == bestVal && (rng_next(rng) % 2 == 0)) {
+                // Choix aléatoire en cas d'égalité
+                *bestRow = i;
+                *bestCol = j;
             }
         }
     }
+    PROF_STOP(get_pool()->prof[PROF_MERGE], t_merge);
 }
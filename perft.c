@@ -0,0 +1,264 @@
+#include <string.h>
+#include "hex.h"
+
+// Perft : compte les positions atteintes à profondeur N et les victoires
+// rencontrées en chemin, en vérifiant à chaque noeud que les noyaux du plateau
+// 1D avec bordure (min_distance, has_won, eval, path_cells) sont d'accord avec
+// ref_distance, un BFS de référence sur une grille 2D avec tests de limites.
+//   ./perft            (positions de référence, comparées aux comptes attendus)
+//   ./perft "pos" N    (position libre : n lignes de n cases '.', 'X', 'O' séparées par '/')
+
+typedef struct {
+    const char *name;
+    int size;
+    const char *position; // NULL : plateau vide de cette taille
+    int depth;
+    long leaves; // Comptes attendus
+    long wins;
+} PerftCase;
+
+static const PerftCase cases[] = {
+    {"vide", 6, NULL, 3, 42840, 0},
+    {"milieu", 6, "..X.../.OX.../..XO../.O.X../...O../......", 3, 19656, 0},
+    {"fin X", 6, "..X.O./.OX.../..XO../.OXX../.X.O../.O....", 3, 11088, 551},
+    {"fin O", 6, "..X.O./.OX.../..XO../.OXX../.XXO../.O....", 3, 9702, 44},
+    {"fin 7", 7, "...X.../..XO.../.OXO.../..X.O../.OX.X../..XO.../.O.....", 3, 36960, 1189},
+    {"vide 11", 11, NULL, 2, 14520, 0},
+    {"fin 11", 11, ".....X....O/....X....../....X....../...XO....../..X.O....../..XO......./"
+                   ".OX......../.X........./.XO......../XO........./.....OO....", 2, 10201, 101},
+    {"vide 19", 19, NULL, 1, 361, 0},
+};
+
+// Compteurs d'un coup de la racine
+typedef struct {
+    long leaves;
+    long wins;
+    long nodes;
+    long errors;
+} PerftCount;
+
+typedef struct {
+    HexGame *game;
+    char player;
+    int depth;
+    int moves[MAX_MOVES];
+    PerftCount counts[MAX_MOVES];
+} PerftRoot;
+
+static const int ref_adjacentes[6][2] = {{-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}}; //(row, col)
+
+// Référence : 0-1 BFS sur une grille 2D sans bordure, avec tests de limites
+static int ref_distance(HexGame *game, char player) {
+    int n = game->size;
+    char grid[MAX_SIZE][MAX_SIZE];
+    int dist[MAX_SIZE][MAX_SIZE];
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            grid[i][j] = game->cells[CELL(game, i, j)];
+            dist[i][j] = INF;
+        }
+    }
+
+    int deque[MAX_MOVES * 2];
+    int front = n * n;
+    int rear = n * n;
+    for (int k = 0; k < n; k++) {
+        int r = (player == PLAYER1) ? 0 : k;
+        int c = (player == PLAYER1) ? k : 0;
+        if (grid[r][c] == player) {
+            dist[r][c] = 0;
+            deque[--front] = r * n + c;
+        } else if (grid[r][c] == EMPTY) {
+            dist[r][c] = 1;
+            deque[rear++] = r * n + c;
+        }
+    }
+
+    while (front < rear) {
+        int curr = deque[front++];
+        int r = curr / n;
+        int c = curr % n;
+        for (int k = 0; k < 6; k++) {
+            int nr = r + ref_adjacentes[k][0];
+            int nc = c + ref_adjacentes[k][1];
+            if (nr < 0 || nr >= n || nc < 0 || nc >= n) continue;
+            if (grid[nr][nc] != player && grid[nr][nc] != EMPTY) continue;
+            int weight = (grid[nr][nc] == player) ? 0 : 1;
+            if (dist[r][c] + weight < dist[nr][nc]) {
+                dist[nr][nc] = dist[r][c] + weight;
+                if (weight == 0) deque[--front] = nr * n + nc;
+                else deque[rear++] = nr * n + nc;
+            }
+        }
+    }
+
+    int d = INF;
+    for (int k = 0; k < n; k++) {
+        int v = (player == PLAYER1) ? dist[n - 1][k] : dist[k][n - 1];
+        if (v < d) d = v;
+    }
+    return d;
+}
+
+// Compare tous les noyaux du plateau avec bordure à la référence
+static bool check_position(HexGame *game) {
+    int d1 = ref_distance(game, PLAYER1);
+    int d2 = ref_distance(game, PLAYER2);
+    bool path[MAX_CELLS];
+    int score = eval(game);
+
+    bool ok = min_distance(game, PLAYER1) == d1 &&
+              min_distance(game, PLAYER2) == d2 &&
+              has_won(game, PLAYER1) == (d1 == 0) &&
+              has_won(game, PLAYER2) == (d2 == 0) &&
+              path_cells(game, PLAYER1, path) == d1 &&
+              path_cells(game, PLAYER2, path) == d2 &&
+              (score == 1000) == (d1 == 0) &&
+              (score == -1000) == (d1 != 0 && d2 == 0);
+    if (!ok) {
+        printf("\nDésaccord (d1=%d d2=%d eval=%d) :", d1, d2, score);
+        print_board(game);
+    }
+    return ok;
+}
+
+static void perft(HexGame *game, char player, int depth, PerftCount *count) {
+    char next = (player == PLAYER1) ? PLAYER2 : PLAYER1;
+    for (int i = 0; i < game->size; i++) {
+        for (int j = 0; j < game->size; j++) {
+            int idx = CELL(game, i, j);
+            if (game->cells[idx] != EMPTY) continue;
+            game->cells[idx] = player;
+            count->nodes++;
+            if (!check_position(game)) count->errors++;
+
+            if (has_won(game, player)) {
+                count->wins++; // Fin de partie : on ne descend pas plus loin
+            } else if (depth == 1) {
+                count->leaves++;
+            } else {
+                perft(game, next, depth - 1, count);
+            }
+            game->cells[idx] = EMPTY;
+        }
+    }
+}
+
+// Tâche du pool : sous-arbre d'un coup de la racine
+static void perft_task(WorkerScratch *w, int t, void *ctx) {
+    PerftRoot *root = ctx;
+    PerftCount *count = &root->counts[t];
+    memset(count, 0, sizeof(*count));
+
+    w->board = *root->game;
+    w->board.cells[root->moves[t]] = root->player;
+    count->nodes = 1;
+    if (!check_position(&w->board)) count->errors++;
+
+    if (has_won(&w->board, root->player)) {
+        count->wins = 1;
+    } else if (root->depth == 1) {
+        count->leaves = 1;
+    } else {
+        char next = (root->player == PLAYER1) ? PLAYER2 : PLAYER1;
+        perft(&w->board, next, root->depth - 1, count);
+    }
+}
+
+// Lecture d'une position "ligne/ligne/..." ; la taille est la longueur de la
+// première ligne, le trait est déduit du nombre de pierres
+static bool parse_position(const char *s, HexGame *game, char *player) {
+    int size = strcspn(s, "/");
+    if (size < 2 || size > MAX_SIZE) return false;
+    init_game(game, size);
+
+    int nb_x = 0, nb_o = 0;
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            char c = *s++;
+            if (c != EMPTY && c != PLAYER1 && c != PLAYER2) return false;
+            game->cells[CELL(game, i, j)] = c;
+            if (c == PLAYER1) nb_x++;
+            if (c == PLAYER2) nb_o++;
+        }
+        if (i < size - 1 && *s++ != '/') return false;
+    }
+    *player = (nb_x == nb_o) ? PLAYER1 : PLAYER2;
+    return *s == '\0';
+}
+
+static PerftCount run_perft(HexGame *game, char player, int depth) {
+    PerftRoot root;
+    root.game = game;
+    root.player = player;
+    root.depth = depth;
+    int nb = 0;
+    for (int i = 0; i < game->size; i++) {
+        for (int j = 0; j < game->size; j++) {
+            if (game->cells[CELL(game, i, j)] == EMPTY) root.moves[nb++] = CELL(game, i, j);
+        }
+    }
+    pool_run(perft_task, &root, nb);
+
+    PerftCount total = {0, 0, 0, 0};
+    for (int t = 0; t < nb; t++) {
+        total.leaves += root.counts[t].leaves;
+        total.wins += root.counts[t].wins;
+        total.nodes += root.counts[t].nodes;
+        total.errors += root.counts[t].errors;
+    }
+    return total;
+}
+
+static bool run_case(const char *name, HexGame *game, char player, int depth, long leaves, long wins) {
+    double start = omp_get_wtime();
+    PerftCount c = run_perft(game, player, depth);
+    double elapsed = omp_get_wtime() - start;
+
+    bool ok = c.errors == 0 && (leaves < 0 || (c.leaves == leaves && c.wins == wins));
+    printf("  %-8s %2dx%-2d prof %d : %ld feuilles, %ld victoires, %ld désaccords - %.0f positions/sec %s\n",
+           name, game->size, game->size, depth, c.leaves, c.wins, c.errors, c.nodes / elapsed,
+           ok ? "OK" : "ECHEC");
+    if (leaves >= 0 && (c.leaves != leaves || c.wins != wins)) {
+        printf("           attendu : %ld feuilles, %ld victoires\n", leaves, wins);
+    }
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    printf("Perft Hex - %d workers\n", get_pool()->nb_threads);
+    HexGame game;
+    char player;
+
+    if (argc == 3) {
+        if (!parse_position(argv[1], &game, &player)) {
+            printf("Position invalide: %s\n", argv[1]);
+            return 1;
+        }
+        // Une profondeur < 1 ne s'arrêterait jamais sur une feuille
+        int depth = atoi(argv[2]);
+        if (depth < 1) {
+            printf("Profondeur invalide: %s (au moins 1)\n", argv[2]);
+            return 1;
+        }
+        return run_case("libre", &game, player, depth, -1, -1) ? 0 : 1;
+    }
+
+    int failures = 0;
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        const PerftCase *pc = &cases[k];
+        if (pc->position == NULL) {
+            init_game(&game, pc->size);
+            player = PLAYER1;
+        } else if (!parse_position(pc->position, &game, &player) || game.size != pc->size) {
+            printf("Position invalide: %s\n", pc->name);
+            failures++;
+            continue;
+        }
+        if (!run_case(pc->name, &game, player, pc->depth, pc->leaves, pc->wins)) {
+            failures++;
+        }
+    }
+    printf("%s\n", failures == 0 ? "Tous les tests perft passent." : "Des tests perft échouent.");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+#define _GNU_SOURCE
+#include <string.h>
+#include <sched.h>
+#include "hex.h"
+
+// Pool de workers unique pour tout le moteur.
+// Les threads OpenMP sont réutilisés d'un coup à l'autre tant que la taille
+// de l'équipe ne change pas : on fixe donc cette taille une seule fois ici.
+static EnginePool pool = {0, BIND_NONE, NULL, NULL, 0, {NULL, 0, 0, 0}, {0}};
+
+const char *prof_names[NB_PROF] = {"eval", "movegen", "merge"};
+
+// Lecture d'un entier dans une variable d'environnement (0 si absente)
+static int env_int(const char *name) {
+    const char *s = getenv(name);
+    return (s != NULL) ? atoi(s) : 0;
+}
+
+// Lecture de la politique d'affinité (none, compact, spread)
+static int env_bind(void) {
+    const char *s = getenv("HEX_BIND");
+    if (s == NULL) return BIND_NONE;
+    if (strcmp(s, "compact") == 0) return BIND_COMPACT;
+    if (strcmp(s, "spread") == 0) return BIND_SPREAD;
+    return BIND_NONE;
+}
+
+// Épingle le thread courant sur un coeur selon la politique choisie
+static void pin_worker(int id, int nb_threads, int bind) {
+#ifdef __linux__
+    int nb_cpus = omp_get_num_procs();
+    int cpu;
+    if (bind == BIND_COMPACT) {
+        cpu = id % nb_cpus; // Workers sur des coeurs consécutifs
+    } else {
+        int stride = (nb_cpus > nb_threads) ? nb_cpus / nb_threads : 1;
+        cpu = (id * stride) % nb_cpus; // Workers répartis sur toute la machine
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)id; (void)nb_threads; (void)bind;
+#endif
+}
+
+#ifdef __linux__
+static cpu_set_t saved_affinity; // Affinité du processus avant l'épinglage des workers
+#endif
+
+// Garde l'affinité du thread appelant : l'épinglage touche aussi le thread 0 (l'appelant)
+static void save_affinity(void) {
+#ifdef __linux__
+    sched_getaffinity(0, sizeof(saved_affinity), &saved_affinity);
+#endif
+}
+
+// Rend à tous les threads de l'équipe (appelant compris) l'affinité d'avant l'épinglage
+static void restore_affinity(int nb_threads) {
+#ifdef __linux__
+    #pragma omp parallel num_threads(nb_threads)
+    {
+        sched_setaffinity(0, sizeof(saved_affinity), &saved_affinity);
+    }
+#else
+    (void)nb_threads;
+#endif
+}
+
+// Crée le pool : nb_threads = 0 -> HEX_THREADS ou nombre de coeurs,
+// bind = BIND_NONE -> HEX_BIND, budget = 0 -> HEX_MEM_BUDGET (Ko) ou MEM_BUDGET.
+// Les scratch des workers et tout le budget mémoire sont alloués une fois.
+void pool_init(int nb_threads, int bind, size_t budget) {
+    pool_free();
+
+    if (nb_threads <= 0) nb_threads = env_int("HEX_THREADS");
+    if (nb_threads <= 0) nb_threads = omp_get_num_procs();
+    if (nb_threads > MAX_THREADS) nb_threads = MAX_THREADS;
+    if (bind == BIND_NONE) bind = env_bind();
+    if (budget == 0) budget = (size_t)env_int("HEX_MEM_BUDGET") * 1024;
+    if (budget == 0) budget = MEM_BUDGET;
+
+    // Un scratch par worker, aligné sur une ligne de cache (pas de faux partage)
+    WorkerScratch *workers = aligned_alloc(64, nb_threads * sizeof(WorkerScratch));
+    if (workers == NULL) {
+        fprintf(stderr, "Erreur : allocation du pool impossible.\n");
+        exit(1);
+    }
+    memset(workers, 0, nb_threads * sizeof(WorkerScratch));
+
+    // Budget fixe : un seul bloc partagé entre le thread appelant et les workers
+    char *memory = malloc(budget);
+    if (memory == NULL) {
+        fprintf(stderr, "Erreur : allocation du budget mémoire impossible.\n");
+        exit(1);
+    }
+    // Part d'un worker : une arena puis le bloc réservé à son pool de noeuds
+    size_t part = (budget / (nb_threads + 1)) & ~(size_t)(ARENA_ALIGN - 1);
+    size_t node_part = (part / NODE_SHARE) & ~(size_t)(ARENA_ALIGN - 1);
+    arena_init(&pool.main_arena, memory, part);
+    for (int i = 0; i < nb_threads; i++) {
+        char *mem = memory + (i + 1) * part;
+        workers[i].id = i;
+        arena_init(&workers[i].arena, mem, part - node_part);
+        node_pool_init(&workers[i].node_pool, mem + part - node_part, node_part, NODE_SIZE);
+    }
+
+    pool.nb_threads = nb_threads;
+    pool.bind = bind;
+    pool.workers = workers;
+    pool.memory = memory;
+    pool.budget = budget;
+
+    // Équipe de taille fixe : le runtime garde ses threads d'une région à l'autre
+    omp_set_dynamic(0);
+
+    // Première région : démarre l'équipe et applique l'affinité une fois pour toutes
+    if (bind != BIND_NONE) save_affinity();
+    #pragma omp parallel num_threads(nb_threads)
+    {
+        if (bind != BIND_NONE) pin_worker(omp_get_thread_num(), nb_threads, bind);
+    }
+}
+
+void pool_free(void) {
+    if (pool.workers != NULL && pool.bind != BIND_NONE) restore_affinity(pool.nb_threads);
+    free(pool.workers);
+    free(pool.memory);
+    pool.workers = NULL;
+    pool.memory = NULL;
+    pool.nb_threads = 0;
+    pool.budget = 0;
+}
+
+// Accès au pool, créé à la demande avec la configuration par défaut
+EnginePool *get_pool(void) {
+    if (pool.workers == NULL) pool_init(0, BIND_NONE, 0);
+    return &pool;
+}
+
+// Exécute nb_tasks tâches de recherche sur les workers du pool.
+// Chaque tâche reçoit le scratch du worker qui l'exécute.
+void pool_run(PoolTask task, void *ctx, int nb_tasks) {
+    EnginePool *p = get_pool();
+
+    // Un seul worker : pas besoin de région parallèle
+    if (p->nb_threads == 1) {
+        for (int t = 0; t < nb_tasks; t++) task(&p->workers[0], t, ctx);
+        return;
+    }
+
+    #pragma omp parallel num_threads(p->nb_threads)
+    {
+        WorkerScratch *w = &p->workers[omp_get_thread_num()];
+        #pragma omp for schedule(dynamic, 1)
+        for (int t = 0; t < nb_tasks; t++) {
+            task(w, t, ctx);
+        }
+    }
+}
+
+// Somme des noeuds visités par tous les workers
+long pool_nodes(void) {
+    EnginePool *p = get_pool();
+    long total = 0;
+    for (int i = 0; i < p->nb_threads; i++) total += p->workers[i].nodes;
+    return total;
+}
+
+void pool_reset_stats(void) {
+    EnginePool *p = get_pool();
+    for (int i = 0; i < p->nb_threads; i++) {
+        p->workers[i].nodes = 0;
+        memset(p->workers[i].prof, 0, sizeof(p->workers[i].prof));
+    }
+    memset(p->prof, 0, sizeof(p->prof));
+}
+
+// Vide les arenas et les pools de noeuds des workers (appelé au début de chaque coup)
+void pool_reset_arenas(void) {
+    EnginePool *p = get_pool();
+    for (int i = 0; i < p->nb_threads; i++) {
+        arena_reset(&p->workers[i].arena);
+        node_pool_reset(&p->workers[i].node_pool);
+    }
+}
+
+// Arena du thread appelant, vidée par son propriétaire
+Arena *main_arena(void) {
+    return &get_pool()->main_arena;
+}
+
+// Arena des données d'un coup (contexte de la racine), vidée par pool_reset_arenas.
+// Le thread appelant est le worker 0 des régions parallèles : c'est la sienne.
+Arena *root_arena(void) {
+    return &get_pool()->workers[0].arena;
+}
+
+void pool_stats(EngineStats *stats) {
+    EnginePool *p = get_pool();
+    stats->nodes = pool_nodes();
+    stats->mem_budget = p->budget;
+    stats->mem_peak = p->main_arena.peak;
+    for (int i = 0; i < p->nb_threads; i++) {
+        NodePool *np = &p->workers[i].node_pool;
+        stats->mem_peak += p->workers[i].arena.peak + np->peak_live * np->node_size;
+    }
+    for (int k = 0; k < NB_PROF; k++) {
+        stats->prof[k] = p->prof[k];
+        for (int i = 0; i < p->nb_threads; i++) stats->prof[k] += p->workers[i].prof[k];
+    }
+}
@@ -0,0 +1,131 @@
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hex.h"
+
+// Format binaire des parties :
+//   en-tête de fichier : "HEXR" + version (5 octets)
+//   par partie : taille, moteur J1, moteur J2, résultat, nombre de coups (u16 LE)
+//   puis un coup par case jouée (row * taille + col), sur 1 octet si le plateau
+//   a au plus 256 cases, sur 2 octets (LE) sinon.
+static const char RECORD_MAGIC[4] = {'H', 'E', 'X', 'R'};
+
+// Nombre d'octets par coup pour une taille de plateau
+int record_move_bytes(int size) {
+    return (size * size <= 256) ? 1 : 2;
+}
+
+// Vide le tampon d'écriture en une seule écriture séquentielle
+static int record_flush(RecordWriter *w) {
+    if (w->len > 0 && fwrite(w->buf, 1, w->len, w->f) != w->len) return -1;
+    w->len = 0;
+    return 0;
+}
+
+int record_open(RecordWriter *w, const char *path) {
+    w->f = fopen(path, "wb");
+    if (w->f == NULL) return -1;
+    w->buf = malloc(RECORD_BUFFER);
+    if (w->buf == NULL) {
+        fclose(w->f);
+        return -1;
+    }
+    w->len = 0;
+    w->nb_games = 0;
+    memcpy(w->buf, RECORD_MAGIC, 4);
+    w->buf[4] = RECORD_VERSION;
+    w->len = 5;
+    return 0;
+}
+
+// Ajoute une partie au tampon (écrit sur disque quand le tampon est plein)
+int record_write(RecordWriter *w, const GameHeader *h, const unsigned short *moves) {
+    int mb = record_move_bytes(h->size);
+    size_t need = 6 + (size_t)h->nb_moves * mb;
+    if (w->len + need > RECORD_BUFFER && record_flush(w) != 0) return -1;
+
+    unsigned char *p = w->buf + w->len;
+    p[0] = h->size;
+    p[1] = h->engine1;
+    p[2] = h->engine2;
+    p[3] = h->result;
+    p[4] = h->nb_moves & 0xFF;
+    p[5] = h->nb_moves >> 8;
+    p += 6;
+    for (int k = 0; k < h->nb_moves; k++) {
+        *p++ = moves[k] & 0xFF;
+        if (mb == 2) *p++ = moves[k] >> 8;
+    }
+    w->len += need;
+    w->nb_games++;
+    return 0;
+}
+
+int record_close(RecordWriter *w) {
+    int ret = record_flush(w);
+    if (fclose(w->f) != 0) ret = -1;
+    free(w->buf);
+    w->buf = NULL;
+    return ret;
+}
+
+// Ouvre un fichier de parties en mmap : rien n'est chargé en mémoire,
+// les pages sont lues à la demande pendant le parcours.
+int reader_open(RecordReader *r, const char *path) {
+    r->data = NULL;
+    r->fd = open(path, O_RDONLY);
+    if (r->fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(r->fd, &st) != 0 || st.st_size < 5) {
+        close(r->fd);
+        return -1;
+    }
+    r->size = st.st_size;
+    r->data = mmap(NULL, r->size, PROT_READ, MAP_PRIVATE, r->fd, 0);
+    if (r->data == MAP_FAILED) {
+        r->data = NULL;
+        close(r->fd);
+        return -1;
+    }
+    madvise((void *)r->data, r->size, MADV_SEQUENTIAL);
+
+    if (memcmp(r->data, RECORD_MAGIC, 4) != 0 || r->data[4] != RECORD_VERSION) {
+        reader_close(r);
+        return -1;
+    }
+    r->pos = 5;
+    return 0;
+}
+
+// Partie suivante : les coups restent dans le fichier mappé (pas de copie).
+// Retourne false à la fin du fichier ou sur une partie tronquée.
+bool reader_next(RecordReader *r, GameHeader *h, const unsigned char **moves) {
+    if (r->pos + 6 > r->size) return false;
+    const unsigned char *p = r->data + r->pos;
+    h->size = p[0];
+    h->engine1 = p[1];
+    h->engine2 = p[2];
+    h->result = p[3];
+    h->nb_moves = p[4] | (p[5] << 8);
+
+    size_t len = (size_t)h->nb_moves * record_move_bytes(h->size);
+    if (r->pos + 6 + len > r->size) return false;
+    *moves = p + 6;
+    r->pos += 6 + len;
+    return true;
+}
+
+// Décode le k-ième coup d'une partie lue
+int record_move(const GameHeader *h, const unsigned char *moves, int k) {
+    if (record_move_bytes(h->size) == 1) return moves[k];
+    return moves[2 * k] | (moves[2 * k + 1] << 8);
+}
+
+void reader_close(RecordReader *r) {
+    if (r->data != NULL) munmap((void *)r->data, r->size);
+    close(r->fd);
+    r->data = NULL;
+}
@@ -0,0 +1,145 @@
+#include <string.h>
+#include "hex.h"
+
+// Générateur de parties IA contre IA au format binaire (record.c)
+//   ./selfplay fichier.hexr nb_parties type1 type2 [taille]   (types : 0 Random, 2 Minimax, 3 Alpha-Beta)
+//   ./selfplay -r fichier.hexr                      (relecture en streaming)
+
+const char* engine_name(int type) {
+    switch(type) {
+        case TYPE_RANDOM: return "Random";
+        case TYPE_MINIMAX: return "Minimax";
+        case TYPE_ALPHABETA: return "AlphaBeta";
+        default: return "Inconnu";
+    }
+}
+
+// Joue une partie et garde tous ses coups dans l'en-tête + moves
+void selfplay_game(int size, int type1, int type2, HexRng *rng, GameHeader *h, unsigned short *moves) {
+    HexGame game;
+    init_game(&game, size);
+    reset_search();
+
+    h->size = size;
+    h->engine1 = type1;
+    h->engine2 = type2;
+    h->result = 0;
+    h->nb_moves = 0;
+
+    for (int turn = 0; turn < size * size; turn++) {
+        char current_player = (turn % 2 == 0) ? PLAYER1 : PLAYER2;
+        int current_type = (turn % 2 == 0) ? type1 : type2;
+        int row = -1, col = -1;
+
+        if (current_type == TYPE_MINIMAX) {
+            best_move_minimax(&game, current_player, &row, &col, turn, rng);
+        } else if (current_type == TYPE_ALPHABETA) {
+            best_move_alphabeta(&game, current_player, &row, &col, turn, rng);
+        } else {
+            play_random_move(&game, rng, &row, &col);
+        }
+        if (row == -1 || col == -1) return; // Ne devrait pas arriver
+
+        game.cells[CELL(&game, row, col)] = current_player;
+        moves[h->nb_moves++] = row * size + col;
+
+        int score = eval(&game);
+        if (score == 1000) {
+            h->result = 1;
+            return;
+        } else if (score == -1000) {
+            h->result = 2;
+            return;
+        }
+    }
+}
+
+// La partie i utilise la graine seed + i : chaque partie se rejoue seule
+int generate(const char *path, int nb_parties, int type1, int type2, int size, unsigned long long seed) {
+    RecordWriter w;
+    if (record_open(&w, path) != 0) {
+        printf("Erreur : impossible de créer %s\n", path);
+        return 1;
+    }
+
+    printf("Self-play %dx%d: %s (J1) vs %s (J2) - %d parties -> %s\n",
+           size, size, engine_name(type1), engine_name(type2), nb_parties, path);
+
+    double start = omp_get_wtime();
+    unsigned short moves[MAX_MOVES];
+    for (int i = 0; i < nb_parties; i++) {
+        GameHeader h;
+        HexRng rng;
+        rng_seed(&rng, seed + i);
+        selfplay_game(size, type1, type2, &rng, &h, moves);
+        if (record_write(&w, &h, moves) != 0) {
+            printf("\nErreur d'écriture dans %s\n", path);
+            record_close(&w);
+            return 1;
+        }
+        printf("\r  Progression: %d/%d", i + 1, nb_parties);
+        fflush(stdout);
+    }
+    double elapsed = omp_get_wtime() - start;
+
+    if (record_close(&w) != 0) {
+        printf("\nErreur d'écriture dans %s\n", path);
+        return 1;
+    }
+    printf("\n  %ld parties en %.2f sec (%.1f parties/sec)\n",
+           w.nb_games, elapsed, w.nb_games / elapsed);
+    return 0;
+}
+
+// Parcourt le fichier sans le charger et affiche un résumé
+int summarize(const char *path) {
+    RecordReader r;
+    if (reader_open(&r, path) != 0) {
+        printf("Erreur : %s n'est pas un fichier de parties valide\n", path);
+        return 1;
+    }
+
+    double start = omp_get_wtime();
+    long nb_games = 0, nb_moves = 0;
+    long victoires[3] = {0, 0, 0};
+    GameHeader h;
+    const unsigned char *moves;
+    while (reader_next(&r, &h, &moves)) {
+        nb_games++;
+        nb_moves += h.nb_moves;
+        if (h.result >= 0 && h.result <= 2) victoires[h.result]++;
+    }
+    double elapsed = omp_get_wtime() - start;
+    reader_close(&r);
+
+    printf("Fichier: %s\n", path);
+    printf("  Parties: %ld (J1: %ld, J2: %ld, nulles: %ld)\n",
+           nb_games, victoires[1], victoires[2], victoires[0]);
+    if (nb_games > 0) {
+        printf("  Longueur moyenne: %.1f coups\n", (double)nb_moves / nb_games);
+    }
+    printf("  Lecture: %.3f sec\n", elapsed);
+    return 0;
+}
+
+// Seuls les moteurs automatiques sont enregistrés (TYPE_HUMAN n'a pas de sens ici)
+bool valid_engine(int type) {
+    return type == TYPE_RANDOM || type == TYPE_MINIMAX || type == TYPE_ALPHABETA;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "-r") == 0) {
+        return summarize(argv[2]);
+    }
+    int size = (argc == 6) ? atoi(argv[5]) : SIZE;
+    if ((argc != 5 && argc != 6) || size < 2 || size > MAX_SIZE ||
+        !valid_engine(atoi(argv[3])) || !valid_engine(atoi(argv[4]))) {
+        printf("Usage: %s fichier.hexr nb_parties type1 type2 [taille]\n", argv[0]);
+        printf("       %s -r fichier.hexr\n", argv[0]);
+        printf("Types: 0 Random, 2 Minimax, 3 Alpha-Beta\n");
+        return 1;
+    }
+
+    unsigned long long seed = engine_setup(); // Poids, HEX_SEARCH, HEX_SEED
+    return generate(argv[1], atoi(argv[2]), atoi(argv[3]), atoi(argv[4]), size, seed);
+}
@@ -3,6 +3,7 @@
 #include "hex.h"
 
 #define NB_PARTIES 50
+#define NB_POSITIONS 30 // Positions au hasard par taille pour le test de la racine
 
 // Types de joueurs pour le test
 #define TEST_RANDOM 0
@@ -19,43 +20,100 @@ const char* type_name(int type) {
 }
 
 // Simule un joueur humain qui joue aléatoirement
-void play_random(HexGame *game, int *row, int *col) {
-    play_random_move(game, row, col);
+void play_random(HexGame *game, HexRng *rng, int *row, int *col) {
+    play_random_move(game, rng, row, col);
+}
+
+// Taille du plateau des parties (argument de la ligne de commande)
+int taille = SIZE;
+
+// Graine des parties (HEX_SEED, sinon l'heure) : la partie i d'une série utilise graine + i
+unsigned long long graine;
+
+// Parties de la série enregistrées si HEX_RECORD est défini (format record.c)
+RecordWriter *recorder = NULL;
+bool record_erreur = false; // Écriture échouée : le fichier de parties est incomplet
+
+// Mesure d'un coup joué : temps, noeuds et moment de la partie
+typedef struct {
+    double temps;
+    long noeuds;
+    int tour; // Numéro du tour (0 = premier coup de la partie)
+    int vides; // Cases vides avant le coup
+} Mesure;
+
+#define MAX_MESURES (NB_PARTIES * MAX_MOVES)
+#define NB_TRANCHES 8 // Tranches de tours du rapport de latence
+#define NB_PHASES 3 // Ouverture, milieu et finale selon les cases vides
+
+// Mesures de la série en cours, par joueur
+Mesure mesures[2][MAX_MESURES];
+int nb_mesures[2];
+double prof_serie[2][NB_PROF]; // Temps par phase du moteur (HEX_PROFILE)
+
+// Conversion type de test -> type moteur (TYPE_*) pour les enregistrements
+int engine_type(int type) {
+    switch(type) {
+        case TEST_MINIMAX: return TYPE_MINIMAX;
+        case TEST_ALPHABETA: return TYPE_ALPHABETA;
+        default: return TYPE_RANDOM;
+    }
 }
 
 // Joue une partie complète et retourne le gagnant (1 ou 2)
-// Retourne aussi le nombre de tours et le temps total
-int play_game(int type1, int type2, int *nb_tours, double *temps_j1, double *temps_j2) {
+// Retourne aussi le nombre de tours, le temps total, les noeuds visités et les coups joués
+int play_game(int type1, int type2, HexRng *rng, int *nb_tours, double *temps_j1, double *temps_j2,
+              long *noeuds_j1, long *noeuds_j2, unsigned short *moves) {
     HexGame game;
-    init_game(&game);
+    init_game(&game, taille);
+    reset_search();
     
     int turn = 0;
     *temps_j1 = 0.0;
     *temps_j2 = 0.0;
+    *noeuds_j1 = 0;
+    *noeuds_j2 = 0;
     
     while (1) {
         char current_player = (turn % 2 == 0) ? PLAYER1 : PLAYER2;
         int current_type = (turn % 2 == 0) ? type1 : type2;
         
         int row = -1, col = -1;
+        pool_reset_stats();
         double start = omp_get_wtime();
         
         if (current_type == TEST_RANDOM) {
-            play_random(&game, &row, &col);
+            play_random(&game, rng, &row, &col);
         } else if (current_type == TEST_MINIMAX) {
-            best_move_minimax(&game, current_player, &row, &col, turn);
+            best_move_minimax(&game, current_player, &row, &col, turn, rng);
         } else if (current_type == TEST_ALPHABETA) {
-            best_move_alphabeta(&game, current_player, &row, &col, turn);
+            best_move_alphabeta(&game, current_player, &row, &col, turn, rng);
         }
         
         double end = omp_get_wtime();
         double elapsed = end - start;
+        long noeuds = pool_nodes();
         
         if (turn % 2 == 0) {
             *temps_j1 += elapsed;
+            *noeuds_j1 += noeuds;
         } else {
             *temps_j2 += elapsed;
+            *noeuds_j2 += noeuds;
+        }
+
+        // Mesure du coup pour le rapport de latence
+        int p = turn % 2;
+        if (nb_mesures[p] < MAX_MESURES) {
+            Mesure *m = &mesures[p][nb_mesures[p]++];
+            m->temps = elapsed;
+            m->noeuds = noeuds;
+            m->tour = turn;
+            m->vides = taille * taille - turn;
         }
+        EngineStats stats;
+        pool_stats(&stats);
+        for (int k = 0; k < NB_PROF; k++) prof_serie[p][k] += stats.prof[k];
         
         if (row == -1 || col == -1) {
             // Erreur, match nul (ne devrait pas arriver)
@@ -63,7 +121,8 @@ int play_game(int type1, int type2, int *nb_tours, double *temps_j1, double *tem
             return 0;
         }
         
-        game.grid[row][col] = current_player;
+        game.cells[CELL(&game, row, col)] = current_player;
+        moves[turn] = row * taille + col;
         
         int score = eval(&game);
         if (score == 1000) {
@@ -77,13 +136,20 @@ int play_game(int type1, int type2, int *nb_tours, double *temps_j1, double *tem
         turn++;
         
         // Sécurité : éviter boucle infinie
-        if (turn > SIZE * SIZE) {
+        if (turn > taille * taille) {
             *nb_tours = turn;
             return 0;
         }
     }
 }
 
+// Percentiles des temps d'un groupe de coups
+typedef struct {
+    int nb;
+    double p50, p90, p99, max;
+    double noeuds_moyen;
+} Latence;
+
 // Structure pour stocker les résultats
 typedef struct {
     int type1;
@@ -93,9 +159,82 @@ typedef struct {
     int matchs_nuls;
     double temps_total_j1;
     double temps_total_j2;
+    long noeuds_total_j1;
+    long noeuds_total_j2;
     int tours_total;
+    Latence latence[2]; // Tous les coups de chaque joueur
+    Latence par_tour[2][NB_TRANCHES];
+    Latence par_phase[2][NB_PHASES];
+    double prof[2][NB_PROF];
 } ResultatMatch;
 
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentile par rang le plus proche sur des temps triés
+static double percentile(const double *tri, int nb, int p) {
+    int rang = (p * nb + 99) / 100;
+    return tri[(rang > 0) ? rang - 1 : 0];
+}
+
+// Latence des coups dont le tour (ou le nombre de cases vides) est dans [lo, hi[
+static Latence calcul_latence(const Mesure *m, int nb, bool par_vides, int lo, int hi) {
+    static double temps[MAX_MESURES];
+    Latence l = {0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    long noeuds = 0;
+    for (int k = 0; k < nb; k++) {
+        int v = par_vides ? m[k].vides : m[k].tour;
+        if (v < lo || v >= hi) continue;
+        temps[l.nb++] = m[k].temps;
+        noeuds += m[k].noeuds;
+    }
+    if (l.nb == 0) return l;
+
+    qsort(temps, l.nb, sizeof(double), compare_double);
+    l.p50 = percentile(temps, l.nb, 50);
+    l.p90 = percentile(temps, l.nb, 90);
+    l.p99 = percentile(temps, l.nb, 99);
+    l.max = temps[l.nb - 1];
+    l.noeuds_moyen = (double)noeuds / l.nb;
+    return l;
+}
+
+// Bornes [lo, hi[ de la tranche de tours k
+static void bornes_tranche(int k, int *lo, int *hi) {
+    int largeur = (taille * taille + NB_TRANCHES - 1) / NB_TRANCHES;
+    *lo = k * largeur;
+    *hi = (k + 1) * largeur;
+    if (*hi > taille * taille) *hi = taille * taille;
+}
+
+// Bornes [lo, hi[ des cases vides de la phase k (0 = ouverture, plateau plein de cases vides)
+static void bornes_phase(int k, int *lo, int *hi) {
+    int cases = taille * taille;
+    *hi = cases - k * cases / NB_PHASES + 1;
+    *lo = (k == NB_PHASES - 1) ? 0 : cases - (k + 1) * cases / NB_PHASES + 1;
+}
+
+// Regroupe les mesures de la série par joueur, par tranche de tours et par phase
+static void rapport_latence(ResultatMatch *res) {
+    for (int p = 0; p < 2; p++) {
+        res->latence[p] = calcul_latence(mesures[p], nb_mesures[p], false, 0, INF);
+        for (int k = 0; k < NB_TRANCHES; k++) {
+            int lo, hi;
+            bornes_tranche(k, &lo, &hi);
+            res->par_tour[p][k] = calcul_latence(mesures[p], nb_mesures[p], false, lo, hi);
+        }
+        for (int k = 0; k < NB_PHASES; k++) {
+            int lo, hi;
+            bornes_phase(k, &lo, &hi);
+            res->par_phase[p][k] = calcul_latence(mesures[p], nb_mesures[p], true, lo, hi);
+        }
+        for (int k = 0; k < NB_PROF; k++) res->prof[p][k] = prof_serie[p][k];
+    }
+}
+
 // Effectue une série de parties entre deux types d'IA
 ResultatMatch run_series(int type1, int type2, int nb_parties) {
     ResultatMatch res;
@@ -106,7 +245,11 @@ ResultatMatch run_series(int type1, int type2, int nb_parties) {
     res.matchs_nuls = 0;
     res.temps_total_j1 = 0.0;
     res.temps_total_j2 = 0.0;
+    res.noeuds_total_j1 = 0;
+    res.noeuds_total_j2 = 0;
     res.tours_total = 0;
+    nb_mesures[0] = nb_mesures[1] = 0;
+    memset(prof_serie, 0, sizeof(prof_serie));
     
     printf("  Test: %s (J1) vs %s (J2) - %d parties\n", 
            type_name(type1), type_name(type2), nb_parties);
@@ -116,8 +259,23 @@ ResultatMatch run_series(int type1, int type2, int nb_parties) {
     for (int i = 0; i < nb_parties; i++) {
         int nb_tours;
         double temps_j1, temps_j2;
+        long noeuds_j1, noeuds_j2;
+        unsigned short moves[MAX_MOVES + 1];
+        HexRng rng;
+        rng_seed(&rng, graine + i);
         
-        int gagnant = play_game(type1, type2, &nb_tours, &temps_j1, &temps_j2);
+        int gagnant = play_game(type1, type2, &rng, &nb_tours, &temps_j1, &temps_j2,
+                                &noeuds_j1, &noeuds_j2, moves);
+
+        if (recorder != NULL) {
+            GameHeader h = {taille, engine_type(type1), engine_type(type2), gagnant, nb_tours};
+            if (record_write(recorder, &h, moves) != 0) {
+                printf("\nErreur d'écriture des parties, enregistrement arrêté.\n");
+                record_close(recorder);
+                recorder = NULL;
+                record_erreur = true;
+            }
+        }
         
         if (gagnant == 1) {
             res.victoires_j1++;
@@ -129,6 +287,8 @@ ResultatMatch run_series(int type1, int type2, int nb_parties) {
         
         res.temps_total_j1 += temps_j1;
         res.temps_total_j2 += temps_j2;
+        res.noeuds_total_j1 += noeuds_j1;
+        res.noeuds_total_j2 += noeuds_j2;
         res.tours_total += nb_tours;
         
         // Calcul du temps pour cette partie
@@ -159,21 +319,206 @@ ResultatMatch run_series(int type1, int type2, int nb_parties) {
         fflush(stdout);
     }
     printf("\n");
-    
+
+    rapport_latence(&res);
     return res;
 }
 
+// Arena et pools de noeuds : allocation, recyclage, remise à zéro et budget épuisé
+bool test_memoire(void) {
+    static char bloc[4096] __attribute__((aligned(64)));
+    bool ok = true;
+
+    // Arena : un dépassement du budget retourne NULL, le reset rend toute la place
+    Arena a;
+    arena_init(&a, bloc, 1024);
+    ok &= arena_alloc(&a, 1000) != NULL;
+    ok &= arena_alloc(&a, 100) == NULL;
+    arena_reset(&a);
+    ok &= arena_alloc(&a, 1024) == bloc && a.peak == 1024;
+
+    // Pool : capacity noeuds distincts, puis NULL
+    NodePool p;
+    void *noeuds[64];
+    node_pool_init(&p, bloc, sizeof(bloc), 64);
+    ok &= p.capacity == 64;
+    for (int k = 0; k < 64; k++) {
+        noeuds[k] = node_alloc(&p);
+        ok &= noeuds[k] != NULL && (k == 0 || noeuds[k] != noeuds[k - 1]);
+    }
+    ok &= node_alloc(&p) == NULL && p.live == 64;
+
+    // Un noeud libéré est réutilisé avant tout autre
+    node_free(&p, noeuds[10]);
+    ok &= node_alloc(&p) == noeuds[10];
+
+    // Après le reset, aucun noeud n'est rendu deux fois
+    node_pool_reset(&p);
+    ok &= p.live == 0 && p.peak_live == 64;
+    for (int k = 0; k < 64; k++) {
+        void *n = node_alloc(&p);
+        ok &= n == noeuds[k];
+    }
+    ok &= node_alloc(&p) == NULL;
+
+    // pool_reset_arenas vide aussi les pools de noeuds des workers
+    NodePool *np = &get_pool()->workers[0].node_pool;
+    void *n = node_alloc(np);
+    pool_reset_arenas();
+    ok &= n != NULL && np->live == 0 && node_alloc(np) == n;
+    pool_reset_arenas();
+
+    if (!ok) printf("  ECHEC: arena ou pool de noeuds\n");
+    return ok;
+}
+
+// Mode déterministe : une même graine doit donner la même partie (coups, gagnant,
+// noeuds visités) avec 1, 2 et 4 workers. Minimax n'est pas rejoué (trop lent sur 6x6),
+// sa racine est fusionnée dans le même ordre que celle d'Alpha-Beta.
+bool test_determinisme(void) {
+    int configs[2][2] = {{TEST_ALPHABETA, TEST_ALPHABETA}, {TEST_RANDOM, TEST_ALPHABETA}};
+    int nb_workers[3] = {1, 2, 4};
+    SearchParams sauvegarde = search_params;
+    search_params.deterministic = 1;
+
+    bool ok = true;
+    for (int c = 0; c < 2; c++) {
+        unsigned short ref_moves[MAX_MOVES + 1];
+        int ref_gagnant = 0, ref_tours = 0;
+        long ref_noeuds = 0;
+        for (int w = 0; w < 3; w++) {
+            pool_init(nb_workers[w], BIND_NONE, 0);
+            HexRng rng;
+            rng_seed(&rng, graine);
+            int nb_tours;
+            double temps_j1, temps_j2;
+            long noeuds_j1, noeuds_j2;
+            unsigned short moves[MAX_MOVES + 1];
+            int gagnant = play_game(configs[c][0], configs[c][1], &rng, &nb_tours, &temps_j1, &temps_j2,
+                                    &noeuds_j1, &noeuds_j2, moves);
+
+            if (w == 0) {
+                ref_gagnant = gagnant;
+                ref_tours = nb_tours;
+                ref_noeuds = noeuds_j1 + noeuds_j2;
+                memcpy(ref_moves, moves, nb_tours * sizeof(unsigned short));
+            } else if (gagnant != ref_gagnant || nb_tours != ref_tours || noeuds_j1 + noeuds_j2 != ref_noeuds ||
+                       memcmp(moves, ref_moves, nb_tours * sizeof(unsigned short)) != 0) {
+                printf("  ECHEC: %s vs %s - %d workers: %d tours, %ld noeuds (attendu %d tours, %ld noeuds)\n",
+                       type_name(configs[c][0]), type_name(configs[c][1]), nb_workers[w],
+                       nb_tours, noeuds_j1 + noeuds_j2, ref_tours, ref_noeuds);
+                ok = false;
+            }
+        }
+    }
+
+    search_params = sauvegarde;
+    pool_init(0, BIND_NONE, 0); // Retour au pool par défaut
+    return ok;
+}
+
+// Fenêtres d'aspiration : le coup choisi par Alpha-Beta doit avoir la valeur maximale
+// trouvée en fenêtre complète. Positions au hasard cherchées l'une après l'autre sans
+// reset_search : le centre de la fenêtre vient de la position précédente et tombe souvent
+// loin du score, ce qui force les échecs bas. Sans LMR ni extension, avec des poids entiers
+// autres que ceux par défaut.
+bool test_valeur_racine(void) {
+    SearchParams sauvegarde = search_params;
+    int poids[NB_FEATURES];
+    memcpy(poids, eval_weights, sizeof(poids));
+    search_params.lmr = 0;
+    search_params.ext = 0;
+    search_params.deterministic = 1;
+    int test_poids[NB_FEATURES] = {5, 1, 1, 2};
+    memcpy(eval_weights, test_poids, sizeof(test_poids));
+
+    WorkerScratch *w = &get_pool()->workers[0]; // Libre entre deux recherches
+    HexRng rng;
+    rng_seed(&rng, graine);
+    reset_search();
+    bool ok = true;
+    for (int size = 4; size <= 5 && ok; size++) {
+        for (int k = 0; k < NB_POSITIONS && ok; k++) {
+            // Position au hasard (un tiers à deux tiers du plateau rempli, pour rester rapide), sans gagnant
+            HexGame game;
+            init_game(&game, size);
+            int nb_pierres = size * size / 3 + rng_next(&rng) % (size * size / 3);
+            char player = PLAYER1;
+            for (int n = 0; n < nb_pierres; n++) {
+                int row, col;
+                play_random_move(&game, &rng, &row, &col);
+                game.cells[CELL(&game, row, col)] = player;
+                player = (player == PLAYER1) ? PLAYER2 : PLAYER1;
+            }
+            if (has_won(&game, PLAYER1) || has_won(&game, PLAYER2)) continue;
+
+            int row, col;
+            best_move_alphabeta(&game, player, &row, &col, nb_pierres, &rng);
+            if (row < 0) {
+                ok = false;
+                break;
+            }
+
+            // Valeur de chaque coup en fenêtre complète, vue du joueur au trait
+            int best = -INF, choisi = -INF;
+            for (int i = 0; i < size; i++) {
+                for (int j = 0; j < size; j++) {
+                    if (!valid_move(&game, i, j)) continue;
+                    w->board = game;
+                    w->board.cells[CELL(&game, i, j)] = player;
+                    int val = (player == PLAYER1)
+                        ? alphabeta(&w->board, PROFALPHABETA, -INF, INF, false, 0, w)
+                        : -alphabeta(&w->board, PROFALPHABETA, -INF, INF, true, 0, w);
+                    if (val > best) best = val;
+                    if (i == row && j == col) choisi = val;
+                }
+            }
+            if (choisi != best) {
+                printf("  ECHEC: %dx%d, coup (%d,%d) de valeur %d, meilleure valeur %d\n",
+                       size, size, row, col, choisi, best);
+                print_board(&game);
+                ok = false;
+            }
+        }
+    }
+
+    search_params = sauvegarde;
+    memcpy(eval_weights, poids, sizeof(poids));
+    return ok;
+}
+
+// Une ligne du rapport de latence (groupe vide ignoré)
+static void ecrire_latence(FILE *f, const char *indent, const char *nom, const Latence *l) {
+    if (l->nb == 0) return;
+    fprintf(f, "  %s%-14s %5d coups - p50 %.2f  p90 %.2f  p99 %.2f  max %.2f - %.0f noeuds/coup\n",
+            indent, nom, l->nb, l->p50 * 1000, l->p90 * 1000, l->p99 * 1000, l->max * 1000, l->noeuds_moyen);
+}
+
 // Écrit les résultats dans un fichier
 void write_results(FILE *f, ResultatMatch *results, int nb_results) {
     fprintf(f, "================================================================================\n");
-    fprintf(f, "                    RÉSULTATS DES TESTS IA - JEU HEX %dx%d\n", SIZE, SIZE);
+    fprintf(f, "                    RÉSULTATS DES TESTS IA - JEU HEX %dx%d\n", taille, taille);
     fprintf(f, "================================================================================\n");
     fprintf(f, "Paramètres:\n");
-    fprintf(f, "  - Taille du plateau: %dx%d\n", SIZE, SIZE);
+    fprintf(f, "  - Taille du plateau: %dx%d\n", taille, taille);
     fprintf(f, "  - Profondeur Minimax: %d\n", PROFMINIMAX);
     fprintf(f, "  - Profondeur Alpha-Beta: %d\n", PROFALPHABETA);
+    fprintf(f, "  - Recherche Alpha-Beta: lmr=%d lmr_depth=%d lmr_full=%d lmr_red=%d ext=%d ext_max=%d ext_threat=%d ext_bridge=%d\n",
+            search_params.lmr, search_params.lmr_min_depth, search_params.lmr_full_moves,
+            search_params.lmr_reduction, search_params.ext, search_params.ext_max, search_params.ext_threat, search_params.ext_bridge);
+    fprintf(f, "  - Graine: %llu%s\n", graine, search_params.deterministic ? " (mode déterministe)" : "");
     fprintf(f, "  - Tours aléatoires au début: %d\n", RANDTOUR);
+    fprintf(f, "  - Poids de l'évaluation:");
+    for (int k = 0; k < NB_FEATURES; k++) fprintf(f, " %s=%d", feature_names[k], eval_weights[k]);
+    fprintf(f, "\n");
     fprintf(f, "  - Nombre de parties par test: %d\n", NB_PARTIES);
+
+    // Statistiques du moteur (pool de workers et budget mémoire)
+    EngineStats stats;
+    pool_stats(&stats);
+    fprintf(f, "  - Workers: %d\n", get_pool()->nb_threads);
+    fprintf(f, "  - Budget mémoire: %zu Ko (pic utilisé: %zu Ko)\n",
+            stats.mem_budget / 1024, stats.mem_peak / 1024);
     fprintf(f, "================================================================================\n\n");
     
     for (int i = 0; i < nb_results; i++) {
@@ -201,6 +546,40 @@ void write_results(FILE *f, ResultatMatch *results, int nb_results) {
         fprintf(f, "    Joueur 2 total: %.2f sec (moyenne: %.4f sec/partie)\n", 
                 r.temps_total_j2, r.temps_total_j2 / NB_PARTIES);
         
+        fprintf(f, "\n  NOEUDS EXPLORÉS:\n");
+        fprintf(f, "    Joueur 1 total: %ld (moyenne: %.0f noeuds/partie)\n",
+                r.noeuds_total_j1, (double)r.noeuds_total_j1 / NB_PARTIES);
+        fprintf(f, "    Joueur 2 total: %ld (moyenne: %.0f noeuds/partie)\n",
+                r.noeuds_total_j2, (double)r.noeuds_total_j2 / NB_PARTIES);
+        
+        fprintf(f, "\n  LATENCE PAR COUP (ms):\n");
+        for (int p = 0; p < 2; p++) {
+            int type = (p == 0) ? r.type1 : r.type2;
+            if (type == TEST_RANDOM) continue;
+            ecrire_latence(f, "  ", p == 0 ? "Joueur 1" : "Joueur 2", &r.latence[p]);
+            fprintf(f, "      Par tour :\n");
+            for (int k = 0; k < NB_TRANCHES; k++) {
+                int lo, hi;
+                char nom[32];
+                bornes_tranche(k, &lo, &hi);
+                sprintf(nom, "tours %d-%d", lo + 1, hi);
+                ecrire_latence(f, "      ", nom, &r.par_tour[p][k]);
+            }
+            fprintf(f, "      Par cases vides :\n");
+            for (int k = 0; k < NB_PHASES; k++) {
+                int lo, hi;
+                char nom[32];
+                bornes_phase(k, &lo, &hi);
+                sprintf(nom, "vides %d-%d", hi - 1, lo);
+                ecrire_latence(f, "      ", nom, &r.par_phase[p][k]);
+            }
+#ifdef HEX_PROFILE
+            fprintf(f, "      Temps par phase du moteur :");
+            for (int k = 0; k < NB_PROF; k++) fprintf(f, " %s=%.3f sec", prof_names[k], r.prof[p][k]);
+            fprintf(f, "\n");
+#endif
+        }
+        
         fprintf(f, "\n  STATISTIQUES:\n");
         fprintf(f, "    Nombre moyen de tours par partie: %.1f\n", 
                 (double)r.tours_total / NB_PARTIES);
@@ -319,14 +698,55 @@ void write_results(FILE *f, ResultatMatch *results, int nb_results) {
     fprintf(f, "\n================================================================================\n");
 }
 
-int main() {
-    srand(time(NULL));
+// Usage : ./test_ia [taille] [nom=valeur,...]  (réglages de la recherche, ex: lmr=0,ext=0)
+int main(int argc, char **argv) {
+    graine = engine_setup(); // Poids, HEX_SEARCH, HEX_SEED ; la ligne de commande passe après
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] >= '0' && argv[i][0] <= '9') {
+            taille = atoi(argv[i]);
+            if (taille < 2 || taille > MAX_SIZE) {
+                printf("Taille invalide (2 à %d).\n", MAX_SIZE);
+                return 1;
+            }
+        } else if (set_search_params(argv[i]) != 0) {
+            printf("Réglage inconnu: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    printf("Mémoire (arena, pools de noeuds)...\n");
+    if (!test_memoire()) return 1;
+    printf("  OK\n");
+
+    printf("Déterminisme (1, 2 et 4 workers, graine %llu)...\n", graine);
+    if (!test_determinisme()) {
+        printf("Le mode déterministe ne donne pas les mêmes parties selon le nombre de workers.\n");
+        return 1;
+    }
+    printf("  OK\n");
+
+    printf("Valeur du coup choisi (fenêtres d'aspiration, 4x4 et 5x5)...\n");
+    if (!test_valeur_racine()) {
+        printf("Alpha-Beta ne choisit pas un coup de valeur maximale.\n");
+        return 1;
+    }
+    printf("  OK\n\n");
+
+    RecordWriter writer;
+    const char *record_path = getenv("HEX_RECORD");
+    if (record_path != NULL) {
+        if (record_open(&writer, record_path) == 0) {
+            recorder = &writer;
+        } else {
+            printf("Erreur: impossible de créer %s, parties non enregistrées.\n", record_path);
+        }
+    }
     
     printf("================================================================================\n");
-    printf("           TEST AUTOMATIQUE DES IA - JEU HEX %dx%d\n", SIZE, SIZE);
+    printf("           TEST AUTOMATIQUE DES IA - JEU HEX %dx%d\n", taille, taille);
     printf("================================================================================\n");
     printf("Configuration:\n");
-    printf("  - Taille: %dx%d\n", SIZE, SIZE);
+    printf("  - Taille: %dx%d\n", taille, taille);
     printf("  - Profondeur Minimax: %d\n", PROFMINIMAX);
     printf("  - Profondeur Alpha-Beta: %d\n", PROFALPHABETA);
     printf("  - Nombre de parties par test: %d\n", NB_PARTIES);
@@ -391,6 +811,13 @@ int main() {
         // Afficher quand même à l'écran
         write_results(stdout, results, nb_results);
     }
+
+    if (recorder != NULL && record_close(recorder) != 0) record_erreur = true;
+    if (record_erreur) {
+        printf("Erreur d'écriture dans %s : fichier de parties incomplet.\n", record_path);
+        return 1;
+    }
+    if (recorder != NULL) printf("Parties enregistrées dans: %s\n", record_path);
     
     return 0;
 }
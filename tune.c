@@ -0,0 +1,186 @@
+#include <math.h>
+#include <string.h>
+#include "hex.h"
+
+// Réglage des poids de eval() à partir de parties enregistrées (record.c).
+//   ./tune parties.hexr [epoques] [fichier_poids]
+// Régression logistique façon Texel : P(victoire J1) = sigmoid(eval / TUNE_SCALE),
+// ajustée par descente de gradient sur toutes les positions des parties.
+
+#define TUNE_SCALE 10.0 // Unités d'eval par unité de logit
+#define TUNE_BATCH 4096 // Parties traitées par lot (lecture en streaming)
+#define TUNE_EPOCHS 50
+#define TUNE_RATE 2.0 // Pas de la descente de gradient (préconditionné par E[f²])
+
+// Accumulateur d'un worker, sur sa propre ligne de cache
+typedef struct {
+    double grad[NB_FEATURES];
+    double sq[NB_FEATURES]; // Somme des f² pour le préconditionnement
+    double loss;
+    long count;
+} __attribute__((aligned(64))) TuneAcc;
+
+// Lot de parties pointant directement dans le fichier mappé
+typedef struct {
+    GameHeader *headers;
+    const unsigned char **moves;
+    int nb_games;
+    const double *weights;
+    TuneAcc acc[MAX_THREADS];
+} TuneBatch;
+
+// Tâche du pool : rejoue une partie et accumule le gradient de ses positions.
+// La partie est accumulée à part et ignorée entièrement si un coup est invalide.
+static void tune_task(WorkerScratch *w, int g, void *ctx) {
+    TuneBatch *batch = ctx;
+    GameHeader *h = &batch->headers[g];
+    if (h->size < 2 || h->size > MAX_SIZE || h->result == 0) return; // Partie nulle ou invalide
+
+    TuneAcc part;
+    memset(&part, 0, sizeof(part));
+    TuneAcc *acc = &part;
+    double y = (h->result == 1) ? 1.0 : 0.0;
+    HexGame *game = &w->board;
+    init_game(game, h->size);
+
+    for (int k = 0; k < h->nb_moves; k++) {
+        int cell = record_move(h, batch->moves[g], k);
+        // Case hors du plateau ou déjà jouée : enregistrement corrompu
+        if (cell >= h->size * h->size) return;
+        int idx = CELL(game, cell / h->size, cell % h->size);
+        if (game->cells[idx] != EMPTY) return;
+        game->cells[idx] = (k % 2 == 0) ? PLAYER1 : PLAYER2;
+
+        int d1 = min_distance(game, PLAYER1);
+        int d2 = min_distance(game, PLAYER2);
+        if (d1 == 0 || d2 == 0) break; // Position terminale : rien à apprendre
+
+        int f[NB_FEATURES];
+        position_features(game, d1, d2, f);
+        double score = 0.0;
+        for (int i = 0; i < NB_FEATURES; i++) score += batch->weights[i] * f[i];
+
+        double p = 1.0 / (1.0 + exp(-score / TUNE_SCALE));
+        // Log-loss : d/dw = (p - y) * f / TUNE_SCALE
+        for (int i = 0; i < NB_FEATURES; i++) {
+            acc->grad[i] += (p - y) * f[i] / TUNE_SCALE;
+            acc->sq[i] += (double)f[i] * f[i];
+        }
+        acc->loss -= y * log(p + 1e-12) + (1.0 - y) * log(1.0 - p + 1e-12);
+        acc->count++;
+    }
+
+    TuneAcc *total = &batch->acc[w->id];
+    for (int i = 0; i < NB_FEATURES; i++) {
+        total->grad[i] += part.grad[i];
+        total->sq[i] += part.sq[i];
+    }
+    total->loss += part.loss;
+    total->count += part.count;
+}
+
+// Une passe complète sur le fichier, lot par lot. Retourne la perte moyenne.
+static double tune_epoch(const char *path, TuneBatch *batch, double grad[NB_FEATURES], double sq[NB_FEATURES]) {
+    RecordReader r;
+    if (reader_open(&r, path) != 0) return -1.0;
+
+    double loss = 0.0;
+    long count = 0;
+    for (int i = 0; i < NB_FEATURES; i++) grad[i] = sq[i] = 0.0;
+
+    bool more = true;
+    while (more) {
+        batch->nb_games = 0;
+        while (batch->nb_games < TUNE_BATCH &&
+               (more = reader_next(&r, &batch->headers[batch->nb_games], &batch->moves[batch->nb_games]))) {
+            batch->nb_games++;
+        }
+        if (batch->nb_games == 0) break;
+
+        memset(batch->acc, 0, sizeof(batch->acc));
+        pool_run(tune_task, batch, batch->nb_games);
+
+        // Réduction des accumulateurs des workers
+        for (int t = 0; t < MAX_THREADS; t++) {
+            for (int i = 0; i < NB_FEATURES; i++) {
+                grad[i] += batch->acc[t].grad[i];
+                sq[i] += batch->acc[t].sq[i];
+            }
+            loss += batch->acc[t].loss;
+            count += batch->acc[t].count;
+        }
+    }
+    reader_close(&r);
+
+    if (count == 0) return -1.0;
+    for (int i = 0; i < NB_FEATURES; i++) {
+        grad[i] /= count;
+        sq[i] /= count;
+    }
+    return loss / count;
+}
+
+int write_weights(const char *path, const int *weights) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return -1;
+    fprintf(f, "# Poids de l'évaluation (générés par tune)\n");
+    for (int i = 0; i < NB_FEATURES; i++) fprintf(f, "%s %d\n", feature_names[i], weights[i]);
+    return fclose(f);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printf("Usage: %s parties.hexr [epoques] [fichier_poids]\n", argv[0]);
+        return 1;
+    }
+    const char *path = argv[1];
+    int epochs = (argc > 2) ? atoi(argv[2]) : TUNE_EPOCHS;
+    const char *out = (argc > 3) ? argv[3] : WEIGHTS_FILE;
+
+    // Tableaux du lot pris une fois dans l'arena du thread principal
+    static TuneBatch batch;
+    Arena *arena = main_arena();
+    batch.headers = arena_alloc(arena, TUNE_BATCH * sizeof(GameHeader));
+    batch.moves = arena_alloc(arena, TUNE_BATCH * sizeof(const unsigned char *));
+    if (batch.headers == NULL || batch.moves == NULL) {
+        printf("Erreur : budget mémoire insuffisant pour un lot de %d parties\n", TUNE_BATCH);
+        return 1;
+    }
+
+    // Départ depuis les poids actuels du moteur
+    load_weights(NULL);
+    double weights[NB_FEATURES];
+    for (int i = 0; i < NB_FEATURES; i++) weights[i] = eval_weights[i];
+    batch.weights = weights;
+
+    printf("Réglage sur %s - %d époques - %d workers\n", path, epochs, get_pool()->nb_threads);
+    double start = omp_get_wtime();
+    for (int e = 0; e < epochs; e++) {
+        double grad[NB_FEATURES], sq[NB_FEATURES];
+        double loss = tune_epoch(path, &batch, grad, sq);
+        if (loss < 0) {
+            printf("Erreur : aucune position exploitable dans %s\n", path);
+            return 1;
+        }
+        // Pas en unités de logit, divisé par E[f²] pour que chaque poids avance à son échelle
+        for (int i = 0; i < NB_FEATURES; i++) {
+            if (sq[i] > 0) weights[i] -= TUNE_RATE * TUNE_SCALE * TUNE_SCALE * grad[i] / sq[i];
+        }
+
+        printf("\r  Époque %d/%d - perte: %.5f", e + 1, epochs, loss);
+        fflush(stdout);
+    }
+    printf("\n  Terminé en %.2f sec\n", omp_get_wtime() - start);
+
+    int result[NB_FEATURES];
+    for (int i = 0; i < NB_FEATURES; i++) {
+        result[i] = (int)lround(weights[i]);
+        printf("  %-8s %d\n", feature_names[i], result[i]);
+    }
+    if (write_weights(out, result) != 0) {
+        printf("Erreur : impossible d'écrire %s\n", out);
+        return 1;
+    }
+    printf("Poids écrits dans: %s\n", out);
+    return 0;
+}